@@ -9,17 +9,33 @@ Boid::Boid()
     : position_{Vector2{}},
       velocity_{Vector2{}},
       velocity_max_{0.f},
-      view_angle_{0.f} {}
+      view_angle_{0.f},
+      view_cos_{1.f},
+      species_{Species::prey} {}
 
 Boid::Boid(Vector2 position, Vector2 velocity, float maximum_velocity,
-           float view_angle)
+           float view_angle, Species species)
     : position_{position},
       velocity_{velocity},
       velocity_max_{maximum_velocity},
-      view_angle_{view_angle} {
+      view_angle_{view_angle},
+      view_cos_{static_cast<float>(std::cos(view_angle * M_PI / 180.))},
+      species_{species} {
   assert(velocity_max_ > 0 && view_angle_ >= 0.f && view_angle_ <= 180.f);
 }
 
+Boid::Boid(Vector2 position, Vector2 velocity, float maximum_velocity,
+           float view_angle, float view_cos, Species species)
+    : position_{position},
+      velocity_{velocity},
+      velocity_max_{maximum_velocity},
+      view_angle_{view_angle},
+      view_cos_{view_cos},
+      species_{species} {
+  assert(velocity_max_ > 0 && view_angle_ >= 0.f && view_angle_ <= 180.f);
+  assert(std::abs(view_cos_ - std::cos(view_angle * M_PI / 180.)) < 1.e-5);
+}
+
 Vector2 Boid::position() const { return position_; }
 
 Vector2 Boid::velocity() const { return velocity_; }
@@ -28,8 +44,14 @@ float Boid::maximum_velocity() const { return velocity_max_; }
 
 float Boid::view_angle() const { return view_angle_; }
 
-float Boid::get_cos_angle(const Boid& other_boid) const {
-  const Vector2 difference = other_boid.position_ - position_;
+float Boid::view_cos() const { return view_cos_; }
+
+Species Boid::species() const { return species_; }
+
+void Boid::set_species(Species species) { species_ = species; }
+
+float Boid::get_cos_angle(const Vector2& other_position) const {
+  const Vector2 difference = other_position - position_;
   const float dot_product = velocity_.dot_product(difference);
 
   const float cos_angle = dot_product / (velocity_.lenght_of_vector() *
@@ -38,8 +60,12 @@ float Boid::get_cos_angle(const Boid& other_boid) const {
   return cos_angle;
 }
 
-float Boid::get_diff_angle(const Boid& other_boid) const {
-  const float cos_angle = get_cos_angle(other_boid);
+float Boid::get_cos_angle(const Boid& other_boid) const {
+  return get_cos_angle(other_boid.position_);
+}
+
+float Boid::get_diff_angle(const Vector2& other_position) const {
+  const float cos_angle = get_cos_angle(other_position);
 
   if (cos_angle < -1.f) {
     return 180.f;
@@ -56,19 +82,48 @@ float Boid::get_diff_angle(const Boid& other_boid) const {
   }
 }
 
-bool Boid::isNear(const Boid& other_boid, float distance_parameter) const {
-  float distance = position_.distance(other_boid.position());
+float Boid::get_diff_angle(const Boid& other_boid) const {
+  return get_diff_angle(other_boid.position_);
+}
 
-  return distance != 0.f && distance < distance_parameter &&
-         get_diff_angle(other_boid) <= view_angle_;
+bool Boid::sees(const Vector2& other_position) const {
+  if (view_angle_ >= 180.f) {
+    return true;
+  }
+
+  // cos(angle) >= view_cos_, multiplied by the lengths and squared: the sign
+  // of the dot product decides which way the inequality goes.
+  const Vector2 difference = other_position - position_;
+  const float dot_product = velocity_.dot_product(difference);
+  const float threshold = view_cos_ * view_cos_ *
+                          velocity_.dot_product(velocity_) *
+                          difference.dot_product(difference);
+
+  if (view_cos_ >= 0.f) {
+    return dot_product >= 0.f && dot_product * dot_product >= threshold;
+
+  } else {
+    return dot_product >= 0.f || dot_product * dot_product <= threshold;
+  }
 }
 
-bool Boid::isRed() const { return boidshape_.getFillColor() == sf::Color::Red; }
+bool Boid::isNear(const Boid& other_boid, float distance_parameter) const {
+  const float squared_distance =
+      position_.squared_distance(other_boid.position());
+
+  return squared_distance != 0.f &&
+         squared_distance < distance_parameter * distance_parameter &&
+         sees(other_boid.position_);
+}
 
 Vector2 Boid::separation(const Boid& other_boid, float separation_parameter,
                          float distance_of_separation) const {
-  if (position_.distance(other_boid.position()) < distance_of_separation &&
-      position_.distance(other_boid.position()) != 0.f && isRed() == true) {
+  const float squared_distance =
+      position_.squared_distance(other_boid.position());
+
+  if (squared_distance < distance_of_separation * distance_of_separation &&
+      squared_distance != 0.f &&
+      default_interaction(species_, other_boid.species_).separation == true) {
     const Vector2 separation_velocity =
         (other_boid.position() - position_) * (-separation_parameter);
 
@@ -84,8 +139,7 @@ Vector2 Boid::separation(const Boid& other_boid, float separation_parameter,
 Vector2 Boid::allignment(const Boid& other_boid, float allignment_parameter,
                          float close_boids, float closeness_parameter) const {
   if (close_boids >= 1.f && isNear(other_boid, closeness_parameter) == true &&
-      boidshape_.getFillColor() == other_boid.get_shape().getFillColor() &&
-      isRed() == true) {
+      default_interaction(species_, other_boid.species_).allignment == true) {
     const Vector2 allignment_velocity = (other_boid.velocity() - velocity_) *
                                         (allignment_parameter / close_boids);
 
@@ -113,76 +167,10 @@ Vector2 Boid::cohesion(const Vector2& center_of_mass,
   }
 }
 
-float Boid::get_rotation_angle() const {
-  if (velocity_.y_axis() != 0.f) {
-    if (velocity_.x_axis() >= 0.f && velocity_.y_axis() > 0.f) {
-      const float angle =
-          (180. / M_PI) *
-              std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())) +
-          2 * (90.f -
-               ((180. / M_PI) *
-                std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis()))));
-      assert(angle >= 90.f && angle <= 180.f);
-
-      return angle;
-    }
-
-    if (velocity_.x_axis() < 0.f && velocity_.y_axis() > 0.f) {
-      const float angle =
-          ((180. / M_PI) *
-           std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis()))) +
-          2 * (90.f -
-               ((180. / M_PI) *
-                std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())))) +
-          2 * ((180. / M_PI) *
-               std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())));
-      assert(angle >= 180.f && angle <= 270.f);
-
-      return angle;
-    }
-
-    if (velocity_.x_axis() <= 0.f && velocity_.y_axis() < 0.f) {
-      const float angle =
-          ((180. / M_PI) *
-           std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis()))) +
-          4 * (90.f -
-               ((180. / M_PI) *
-                std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())))) +
-          2 * ((180. / M_PI) *
-               std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())));
-      assert(angle >= 270.f && angle <= 360.f);
-
-      return angle;
-    }
-
-    if (velocity_.x_axis() > 0.f && velocity_.y_axis() < 0.f) {
-      const float angle =
-          ((180. / M_PI) *
-           std::atan(std::abs(velocity_.x_axis() / velocity_.y_axis())));
-      assert(angle >= 0.f && angle <= 90.f);
-
-      return angle;
-    }
-
-  } else {
-    if (velocity_.x_axis() < 0.f && velocity_.y_axis() == 0.f) {
-      return 270.f;
-    }
-
-    if (velocity_.x_axis() > 0.f && velocity_.y_axis() == 0.f) {
-      return 90.f;
-    }
-
-    if (velocity_.x_axis() == 0.f && velocity_.y_axis() == 0.f) {
-      return 0.f;
-    }
-  }
-
-  return 180.f;
-}
+float Boid::get_rotation_angle() const { return rotation_angle(velocity_); }
 
 void Boid::limit_velocity() {
-  if (velocity_.lenght_of_vector() >= velocity_max_) {
+  if (velocity_.squared_lenght_of_vector() >= velocity_max_ * velocity_max_) {
     velocity_ = velocity_ * 0.5f;
   }
 }
@@ -199,35 +187,20 @@ bool Boid::operator==(const Boid& other_boid) const {
   return (position_ == other_boid.position_ &&
           velocity_ == other_boid.velocity_ &&
           velocity_max_ == other_boid.velocity_max_ &&
-          view_angle_ == other_boid.view_angle_);
-};
-
-sf::CircleShape& Boid::set_shape() { return boidshape_; }
-
-const sf::CircleShape& Boid::get_shape() const { return boidshape_; }
-
-void Boid::setRadius(float radius) { boidshape_.setRadius(radius); }
-
-void Boid::setPointCount() { boidshape_.setPointCount(3); }
-
-void Boid::setOrigin(float origin_x, float origin_y) {
-  boidshape_.setOrigin(origin_x, origin_y);
-}
-
-void Boid::setScale(float scale_x, float scale_y) {
-  boidshape_.setScale(scale_x, scale_y);
-}
-
-void Boid::setFillColor(const sf::Color& color) {
-  boidshape_.setFillColor(color);
+          view_angle_ == other_boid.view_angle_ &&
+          species_ == other_boid.species_);
 }
 
-void Boid::setPosition(const Vector2& new_position) {
-  const sf::Vector2f graphic_position{new_position.x_axis(),
-                                      new_position.y_axis()};
-  boidshape_.setPosition(graphic_position);
-};
+float rotation_angle(const Vector2& velocity) {
+  if (velocity == Vector2{}) {
+    return 0.f;
+  }
 
-void Boid::setRotation() { boidshape_.setRotation(get_rotation_angle()); }
+  // clockwise from the negative y axis, which points up in the window.
+  const float angle = (180. / M_PI) * std::atan2(velocity.x_axis(),
+                                                 -velocity.y_axis());
+  assert(angle >= -180.f && angle <= 180.f);
 
-}  // namespace pr
\ No newline at end of file
+  return angle < 0.f ? angle + 360.f : angle;
+}
+}  // namespace pr
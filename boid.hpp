@@ -1,7 +1,7 @@
 #ifndef BOID_HPP
 #define BOID_HPP
 
-#include "SFML/Graphics.hpp"
+#include "species.hpp"
 #include "vector2.hpp"
 
 namespace pr {
@@ -14,13 +14,20 @@ class Boid {
 
   float view_angle_;
 
-  sf::CircleShape boidshape_;
+  float view_cos_;  // cosine of view_angle_, so that sees() needs no acos.
+
+  Species species_;
 
  public:
   Boid();
 
   Boid(Vector2 position, Vector2 velocity, float maximum_velocity,
-       float view_angle);
+       float view_angle, Species species = Species::prey);
+
+  // the same, with the cosine of "view_angle" already computed (e.g. kept by
+  // a Boid_store), so that no trigonometric function is called.
+  Boid(Vector2 position, Vector2 velocity, float maximum_velocity,
+       float view_angle, float view_cos, Species species);
 
   Vector2 position() const;
 
@@ -30,14 +37,29 @@ class Boid {
 
   float view_angle() const;
 
+  float view_cos() const;
+
+  Species species() const;
+
+  void set_species(Species species);
+
+  float get_cos_angle(const Vector2& other_position) const;
+
   float get_cos_angle(const Boid& other_boid) const;
 
+  float get_diff_angle(const Vector2& other_position) const;
+
   float get_diff_angle(const Boid& other_boid) const;
 
-  bool isNear(const Boid& other_boid, float distance_parameter) const;
+  // whether "other_position" is inside the view of the boid, i.e. whether
+  // get_diff_angle(other_position) <= view_angle(), decided by comparing
+  // the dot product with the squared lengths: no sqrt and no acos.
+  bool sees(const Vector2& other_position) const;
 
-  bool isRed() const;
+  bool isNear(const Boid& other_boid, float distance_parameter) const;
 
+  // the rules between two boids follow the default_interaction() of their
+  // species (a Flock can be given a different table).
   Vector2 separation(const Boid& other_boid, float separation_parameter,
                      float distance_of_separation) const;
 
@@ -56,29 +78,11 @@ class Boid {
   void change_position(const Vector2& position_offset);
 
   bool operator==(const Boid& other_boid) const;
-
-  sf::CircleShape& set_shape();
-
-  const sf::CircleShape& get_shape()
-      const;  // function with the only purpose of reading "boidshape",
-              // necessary to call as a function argument a "const boid" object,
-              // when on its shape are used methods which don't modify it, as
-              // "getFillColor()".
-
-  void setRadius(float radius);
-
-  void setPointCount();
-
-  void setOrigin(float origin_x, float origin_y);
-
-  void setScale(float scale_x, float scale_y);
-
-  void setFillColor(const sf::Color& color);
-
-  void setPosition(const Vector2& new_position);
-
-  void setRotation();
 };
+
+// the rotation, in degrees between 0 and 360, of a shape pointing up which moves
+// with "velocity" (0 if it doesn't move): it is only needed to draw a boid.
+float rotation_angle(const Vector2& velocity);
 }  // namespace pr
 
 #endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#define _USE_MATH_DEFINES
+#include "boid_store.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace pr {
+std::size_t Boid_store::size() const { return x_.size(); }
+
+bool Boid_store::empty() const { return x_.empty(); }
+
+void Boid_store::reserve(std::size_t capacity) {
+  x_.reserve(capacity);
+  y_.reserve(capacity);
+  velocity_x_.reserve(capacity);
+  velocity_y_.reserve(capacity);
+  velocity_max_.reserve(capacity);
+  view_angle_.reserve(capacity);
+  view_cos_.reserve(capacity);
+  species_.reserve(capacity);
+  id_.reserve(capacity);
+}
+
+void Boid_store::push_back(const Boid& new_boid) {
+  push_back(new_boid, id_.size());
+}
+
+void Boid_store::push_back(const Boid& new_boid, std::size_t id) {
+  x_.push_back(new_boid.position().x_axis());
+  y_.push_back(new_boid.position().y_axis());
+  velocity_x_.push_back(new_boid.velocity().x_axis());
+  velocity_y_.push_back(new_boid.velocity().y_axis());
+  velocity_max_.push_back(new_boid.maximum_velocity());
+  view_angle_.push_back(new_boid.view_angle());
+  view_cos_.push_back(new_boid.view_cos());
+  species_.push_back(new_boid.species());
+  id_.push_back(id);
+}
+
+void Boid_store::emplace_back(const Vector2& position, const Vector2& velocity,
+                              float maximum_velocity, float view_angle,
+                              Species species, std::size_t id) {
+  x_.push_back(position.x_axis());
+  y_.push_back(position.y_axis());
+  velocity_x_.push_back(velocity.x_axis());
+  velocity_y_.push_back(velocity.y_axis());
+  velocity_max_.push_back(maximum_velocity);
+  view_angle_.push_back(view_angle);
+  view_cos_.push_back(static_cast<float>(std::cos(view_angle * M_PI / 180.)));
+  species_.push_back(species);
+  id_.push_back(id);
+}
+
+void Boid_store::swap_and_pop(std::size_t index) {
+  assert(index < size());
+  const std::size_t last = size() - 1;
+
+  if (index != last) {
+    x_[index] = x_[last];
+    y_[index] = y_[last];
+    velocity_x_[index] = velocity_x_[last];
+    velocity_y_[index] = velocity_y_[last];
+    velocity_max_[index] = velocity_max_[last];
+    view_angle_[index] = view_angle_[last];
+    view_cos_[index] = view_cos_[last];
+    species_[index] = species_[last];
+    id_[index] = id_[last];
+  }
+
+  x_.pop_back();
+  y_.pop_back();
+  velocity_x_.pop_back();
+  velocity_y_.pop_back();
+  velocity_max_.pop_back();
+  view_angle_.pop_back();
+  view_cos_.pop_back();
+  species_.pop_back();
+  id_.pop_back();
+}
+
+void Boid_store::gather(const Boid_store& source,
+                        const std::vector<std::size_t>& order) {
+  assert(this != &source);
+  const std::size_t count = order.size();
+
+  x_.resize(count);
+  y_.resize(count);
+  velocity_x_.resize(count);
+  velocity_y_.resize(count);
+  velocity_max_.resize(count);
+  view_angle_.resize(count);
+  view_cos_.resize(count);
+  species_.resize(count);
+  id_.resize(count);
+
+  for (std::size_t i{0}; i < count; ++i) {
+    const std::size_t from = order[i];
+    assert(from < source.size());
+
+    x_[i] = source.x_[from];
+    y_[i] = source.y_[from];
+    velocity_x_[i] = source.velocity_x_[from];
+    velocity_y_[i] = source.velocity_y_[from];
+    velocity_max_[i] = source.velocity_max_[from];
+    view_angle_[i] = source.view_angle_[from];
+    view_cos_[i] = source.view_cos_[from];
+    species_[i] = source.species_[from];
+    id_[i] = source.id_[from];
+  }
+}
+
+Boid Boid_store::boid(std::size_t index) const {
+  assert(index < size());
+
+  Boid result{Vector2{x_[index], y_[index]},
+              Vector2{velocity_x_[index], velocity_y_[index]},
+              velocity_max_[index], view_angle_[index], view_cos_[index],
+              species_[index]};
+
+  return result;
+}
+
+void Boid_store::set_boid(std::size_t index, const Boid& new_boid) {
+  assert(index < size());
+
+  set_position(index, new_boid.position());
+  set_velocity(index, new_boid.velocity());
+  velocity_max_[index] = new_boid.maximum_velocity();
+  view_angle_[index] = new_boid.view_angle();
+  view_cos_[index] = new_boid.view_cos();
+  species_[index] = new_boid.species();
+}
+
+Vector2 Boid_store::position(std::size_t index) const {
+  return Vector2{x_[index], y_[index]};
+}
+
+Vector2 Boid_store::velocity(std::size_t index) const {
+  return Vector2{velocity_x_[index], velocity_y_[index]};
+}
+
+float Boid_store::maximum_velocity(std::size_t index) const {
+  return velocity_max_[index];
+}
+
+float Boid_store::view_angle(std::size_t index) const {
+  return view_angle_[index];
+}
+
+float Boid_store::view_cos(std::size_t index) const {
+  return view_cos_[index];
+}
+
+Species Boid_store::species(std::size_t index) const {
+  return species_[index];
+}
+
+std::size_t Boid_store::id(std::size_t index) const { return id_[index]; }
+
+void Boid_store::set_position(std::size_t index, const Vector2& new_position) {
+  x_[index] = new_position.x_axis();
+  y_[index] = new_position.y_axis();
+}
+
+void Boid_store::set_velocity(std::size_t index, const Vector2& new_velocity) {
+  velocity_x_[index] = new_velocity.x_axis();
+  velocity_y_[index] = new_velocity.y_axis();
+}
+
+Boid_store::const_iterator::const_iterator(const Boid_store& store,
+                                           std::size_t index)
+    : store_{&store}, index_{index} {}
+
+Boid_view Boid_store::const_iterator::operator*() const {
+  return Boid_view{*store_, index_};
+}
+
+Boid_store::const_iterator& Boid_store::const_iterator::operator++() {
+  ++index_;
+
+  return *this;
+}
+
+bool Boid_store::const_iterator::operator==(
+    const const_iterator& other) const {
+  return store_ == other.store_ && index_ == other.index_;
+}
+
+bool Boid_store::const_iterator::operator!=(
+    const const_iterator& other) const {
+  return !(*this == other);
+}
+
+Boid_store::const_iterator Boid_store::begin() const {
+  return const_iterator{*this, 0};
+}
+
+Boid_store::const_iterator Boid_store::end() const {
+  return const_iterator{*this, size()};
+}
+
+Boid_view Boid_store::operator[](std::size_t index) const {
+  assert(index < size());
+
+  return Boid_view{*this, index};
+}
+
+Boid_view::Boid_view(const Boid_store& store, std::size_t index)
+    : store_{&store}, index_{index} {}
+
+std::size_t Boid_view::index() const { return index_; }
+
+std::size_t Boid_view::id() const { return store_->id(index_); }
+
+Vector2 Boid_view::position() const { return store_->position(index_); }
+
+Vector2 Boid_view::velocity() const { return store_->velocity(index_); }
+
+float Boid_view::maximum_velocity() const {
+  return store_->maximum_velocity(index_);
+}
+
+float Boid_view::view_angle() const { return store_->view_angle(index_); }
+
+Species Boid_view::species() const { return store_->species(index_); }
+
+float Boid_view::get_rotation_angle() const {
+  return rotation_angle(velocity());
+}
+
+Boid Boid_view::boid() const { return store_->boid(index_); }
+}  // namespace pr
@@ -0,0 +1,149 @@
+#ifndef BOID_STORE_HPP
+#define BOID_STORE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "boid.hpp"
+
+namespace pr {
+class Boid_view;
+
+// structure-of-arrays storage of the boids of a flock: every field lives in
+// its own contiguous array, so that a scan only loads the fields it reads
+// (the hot state of a boid takes 29 bytes overall).
+class Boid_store {
+  std::vector<float> x_;
+
+  std::vector<float> y_;
+
+  std::vector<float> velocity_x_;
+
+  std::vector<float> velocity_y_;
+
+  std::vector<float> velocity_max_;
+
+  std::vector<float> view_angle_;
+
+  std::vector<float> view_cos_;  // cosine of view_angle_, computed once when
+                                 // the boid is added: boid() calls no cos.
+
+  std::vector<Species> species_;
+
+  std::vector<std::size_t> id_;  // cold: only read to find a boid again.
+
+ public:
+  std::size_t size() const;
+
+  bool empty() const;
+
+  void reserve(std::size_t capacity);
+
+  // the new boid gets the id size(): as long as the ids of the store are
+  // 0, 1, ..., size() - 1 in any order, they stay unique.
+  void push_back(const Boid& new_boid);
+
+  // for the owners which recycle the ids of the removed boids.
+  void push_back(const Boid& new_boid, std::size_t id);
+
+  // the same, straight from the fields: no Boid is built.
+  void emplace_back(const Vector2& position, const Vector2& velocity,
+                    float maximum_velocity, float view_angle, Species species,
+                    std::size_t id);
+
+  // removes the boid at "index" in O(1): the last boid takes its place.
+  void swap_and_pop(std::size_t index);
+
+  // fills the store with the boids source[order[0]], source[order[1]], ...,
+  // ids included: a reordering of "source" keeps the memory of this store.
+  void gather(const Boid_store& source, const std::vector<std::size_t>& order);
+
+  Boid boid(std::size_t index) const;
+
+  void set_boid(std::size_t index, const Boid& new_boid);
+
+  Vector2 position(std::size_t index) const;
+
+  Vector2 velocity(std::size_t index) const;
+
+  float maximum_velocity(std::size_t index) const;
+
+  float view_angle(std::size_t index) const;
+
+  float view_cos(std::size_t index) const;
+
+  Species species(std::size_t index) const;
+
+  // which boid is stored at "index": the index it had when it was added,
+  // which doesn't change when the store is reordered.
+  std::size_t id(std::size_t index) const;
+
+  void set_position(std::size_t index, const Vector2& new_position);
+
+  void set_velocity(std::size_t index, const Vector2& new_velocity);
+
+  // read-only iteration: every element is a Boid_view of the store, so a scan
+  // of the whole flock copies nothing.
+  class const_iterator {
+    const Boid_store* store_;
+
+    std::size_t index_;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Boid_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Boid_view;
+
+    const_iterator(const Boid_store& store, std::size_t index);
+
+    Boid_view operator*() const;
+
+    const_iterator& operator++();
+
+    bool operator==(const const_iterator& other) const;
+
+    bool operator!=(const const_iterator& other) const;
+  };
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  Boid_view operator[](std::size_t index) const;
+};
+
+// the boid stored at "index", read field by field straight from the store,
+// so it always shows the current state of the boid: it can't outlive the
+// store.
+class Boid_view {
+  const Boid_store* store_;
+
+  std::size_t index_;
+
+ public:
+  Boid_view(const Boid_store& store, std::size_t index);
+
+  std::size_t index() const;
+
+  std::size_t id() const;
+
+  Vector2 position() const;
+
+  Vector2 velocity() const;
+
+  float maximum_velocity() const;
+
+  float view_angle() const;
+
+  Species species() const;
+
+  float get_rotation_angle() const;
+
+  Boid boid() const;  // a copy of the boid, to use the rules of the Boid.
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,154 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "boid_store.hpp"
+
+#include "doctest.h"
+
+TEST_CASE("Testing the push_back() and boid() methods") {
+  const pr::Vector2 v1{50.f, 40.f};
+  const pr::Vector2 v2{-3.f, 4.f};
+  const pr::Vector2 v3{100.f, 60.f};
+  const pr::Vector2 v4{1.f, 2.f};
+
+  const pr::Boid b1{v1, v2, 500.f, 150.f, pr::Species::prey};
+  const pr::Boid b2{v3, v4, 200.f, 120.f, pr::Species::predator};
+
+  pr::Boid_store store;
+  store.push_back(b1);
+  store.push_back(b2);
+
+  CHECK(store.size() == 2);
+  CHECK(store.boid(0) == b1);
+  CHECK(store.boid(1) == b2);
+
+  CHECK(store.position(1).x_axis() == doctest::Approx(100.0).epsilon(0.1));
+  CHECK(store.position(1).y_axis() == doctest::Approx(60.0).epsilon(0.1));
+  CHECK(store.velocity(0).x_axis() == doctest::Approx(-3.0).epsilon(0.1));
+  CHECK(store.velocity(0).y_axis() == doctest::Approx(4.0).epsilon(0.1));
+  CHECK(store.species(0) == pr::Species::prey);
+  CHECK(store.species(1) == pr::Species::predator);
+
+  // the cosine of the view angle is kept, not computed again by boid().
+  CHECK(store.view_cos(0) == b1.view_cos());
+  CHECK(store.view_cos(1) == doctest::Approx(-0.5));
+  CHECK(store.boid(1).view_cos() == b2.view_cos());
+
+  store.emplace_back(v1, v2, 500.f, 90.f, pr::Species::prey, 2);
+  CHECK(store.view_cos(2) == doctest::Approx(0.0));
+}
+
+TEST_CASE("Testing the set_position(), set_velocity() and set_boid() methods") {
+  const pr::Vector2 v1{50.f, 40.f};
+  const pr::Vector2 v2{-3.f, 4.f};
+
+  pr::Boid_store store;
+  store.push_back(pr::Boid{v1, v2, 500.f, 150.f});
+  store.push_back(pr::Boid{v2, v1, 500.f, 150.f});
+
+  SUBCASE("Single fields:") {
+    store.set_position(0, pr::Vector2{7.f, 8.f});
+    store.set_velocity(0, pr::Vector2{9.f, 10.f});
+
+    CHECK(store.boid(0) == pr::Boid{pr::Vector2{7.f, 8.f},
+                                    pr::Vector2{9.f, 10.f}, 500.f, 150.f});
+    CHECK(store.boid(1) == pr::Boid{v2, v1, 500.f, 150.f});
+  }
+
+  SUBCASE("Whole boid:") {
+    const pr::Boid b3{v2, v2, 30.f, 100.f, pr::Species::predator};
+    store.set_boid(1, b3);
+
+    CHECK(store.boid(0) == pr::Boid{v1, v2, 500.f, 150.f});
+    CHECK(store.boid(1) == b3);
+  }
+}
+
+TEST_CASE("Testing the read-only views of the store") {
+  const pr::Vector2 v1{50.f, 40.f};
+  const pr::Vector2 v2{-3.f, 4.f};
+
+  pr::Boid_store store;
+  store.push_back(pr::Boid{v1, v2, 500.f, 150.f, pr::Species::prey});
+  store.push_back(pr::Boid{v2, v1, 200.f, 120.f, pr::Species::predator});
+
+  SUBCASE("Single view:") {
+    const pr::Boid_view view = store[1];
+
+    CHECK(view.index() == 1);
+    CHECK(view.position() == v2);
+    CHECK(view.velocity() == v1);
+    CHECK(view.maximum_velocity() == doctest::Approx(200.0).epsilon(0.1));
+    CHECK(view.view_angle() == doctest::Approx(120.0).epsilon(0.1));
+    CHECK(view.species() == pr::Species::predator);
+    CHECK(view.boid() == store.boid(1));
+  }
+
+  SUBCASE("The view follows the changes of the store:") {
+    const pr::Boid_view view = store[0];
+    store.set_position(0, pr::Vector2{7.f, 8.f});
+
+    CHECK(view.position() == pr::Vector2{7.f, 8.f});
+  }
+
+  SUBCASE("Iteration:") {
+    std::size_t visited{0};
+
+    for (const pr::Boid_view view : store) {
+      CHECK(view.boid() == store.boid(visited));
+      ++visited;
+    }
+
+    CHECK(visited == 2);
+  }
+}
+
+TEST_CASE("Testing the ids and the gather() method") {
+  pr::Boid_store store;
+  for (int i{0}; i < 4; ++i) {
+    const float coordinate = static_cast<float>(i);
+    store.push_back(pr::Boid{pr::Vector2{coordinate, coordinate},
+                             pr::Vector2{-coordinate, 1.f}, 10.f, 150.f});
+  }
+
+  for (std::size_t i{0}; i < store.size(); ++i) {
+    CHECK(store.id(i) == i);
+    CHECK(store[i].id() == i);
+  }
+
+  pr::Boid_store reordered;
+  reordered.gather(store, std::vector<std::size_t>{2, 0, 3, 1});
+
+  CHECK(reordered.size() == 4);
+  CHECK(reordered.boid(0) == store.boid(2));
+  CHECK(reordered.boid(1) == store.boid(0));
+  CHECK(reordered.boid(2) == store.boid(3));
+  CHECK(reordered.boid(3) == store.boid(1));
+  CHECK(reordered.id(0) == 2);
+  CHECK(reordered.id(3) == 1);
+
+  // the new boids get the next id, whatever the order.
+  reordered.push_back(store.boid(0));
+  CHECK(reordered.id(4) == 4);
+}
+
+TEST_CASE("Testing the swap_and_pop() method") {
+  pr::Boid_store store;
+  for (int i{0}; i < 3; ++i) {
+    const float coordinate = static_cast<float>(i);
+    store.push_back(pr::Boid{pr::Vector2{coordinate, coordinate},
+                             pr::Vector2{-coordinate, 1.f}, 10.f, 150.f});
+  }
+  const pr::Boid last = store.boid(2);
+
+  store.swap_and_pop(0);
+  CHECK(store.size() == 2);
+  CHECK(store.boid(0) == last);
+  CHECK(store.id(0) == 2);
+  CHECK(store.id(1) == 1);
+
+  store.swap_and_pop(1);
+  CHECK(store.size() == 1);
+  CHECK(store.id(0) == 2);
+
+  store.push_back(last, 7);
+  CHECK(store.id(1) == 7);
+}
@@ -1,6 +1,8 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "boid.hpp"
 
+#include <cmath>
+
 #include "doctest.h"
 
 TEST_CASE("Testing the get_diff_angle() and isNear() methods") {
@@ -101,13 +103,13 @@ TEST_CASE("Testing the separation() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 3.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{3.f, 4.f};
     const pr::Vector2 v_j{1.f, 1.f};
 
     pr::Boid B_j{x_j, v_j, 6.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float s = 1.f;
     const float ds = 5.f;
@@ -125,13 +127,13 @@ TEST_CASE("Testing the separation() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 20.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{6.78f, 4.4f};
     const pr::Vector2 v_j{1.f, 1.f};
 
     pr::Boid B_j{x_j, v_j, 20.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float s = 3.f;
     const float ds = 5.f;
@@ -148,13 +150,13 @@ TEST_CASE("Testing the separation() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 100.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{-7.98f, 22.55f};
     const pr::Vector2 v_j{1.f, 1.f};
 
     pr::Boid B_j{x_j, v_j, 100.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float s = 7.90f;
     const float ds = 40.f;
@@ -172,13 +174,13 @@ TEST_CASE("testing the allignment() method") {
     const pr::Vector2 v_i{3.f, 5.f};
 
     pr::Boid B_i{x_i, v_i, 20.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{2.f, 1.f};
     const pr::Vector2 v_j{4.f, 7.f};
 
     pr::Boid B_j{x_j, v_j, 20.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float a = 0.5f;
     const float n = 9.f;
@@ -194,13 +196,13 @@ TEST_CASE("testing the allignment() method") {
     const pr::Vector2 v_i{-1.f, -9.f};
 
     pr::Boid B_i{x_i, v_i, 20.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{2.f, 1.f};
     const pr::Vector2 v_j{-12.f, -7.f};
 
     pr::Boid B_j{x_j, v_j, 30.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float a = 0.7f;
     const float n = 19.f;
@@ -217,13 +219,13 @@ TEST_CASE("testing the allignment() method") {
     const pr::Vector2 v_i{1.01f, -7.85f};
 
     pr::Boid B_i{x_i, v_i, 20.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     const pr::Vector2 x_j{2.f, 1.f};
     const pr::Vector2 v_j{-8.98f, 15.1f};
 
     pr::Boid B_j{x_j, v_j, 30.f, 180.f};
-    B_j.set_shape().setFillColor(sf::Color::Red);
+    B_j.set_species(pr::Species::prey);
 
     const float a = 0.2f;
     const float n = 49.f;
@@ -245,7 +247,7 @@ TEST_CASE("testing the cohesion() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 20.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     pr::Vector2 v3 = B_i.cohesion(x_cm, c);
 
@@ -262,7 +264,7 @@ TEST_CASE("testing the cohesion() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 5.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     pr::Vector2 v3 = B_i.cohesion(x_cm, c);
 
@@ -279,7 +281,7 @@ TEST_CASE("testing the cohesion() method") {
     const pr::Vector2 v_i{1.f, 1.f};
 
     pr::Boid B_i{x_i, v_i, 50.f, 180.f};
-    B_i.set_shape().setFillColor(sf::Color::Red);
+    B_i.set_species(pr::Species::prey);
 
     pr::Vector2 v3 = B_i.cohesion(x_cm, c);
 
@@ -324,6 +326,19 @@ TEST_CASE("Testing the get_rotation_angle() function") {
 
     CHECK(b1.get_rotation_angle() == doctest::Approx(45.0).epsilon(0.1));
   }
+
+  SUBCASE("Velocity along the axes:") {
+    CHECK(pr::rotation_angle(pr::Vector2{0.f, -3.f}) == doctest::Approx(0.0));
+    CHECK(pr::rotation_angle(pr::Vector2{3.f, 0.f}) == doctest::Approx(90.0));
+    CHECK(pr::rotation_angle(pr::Vector2{0.f, 3.f}) == doctest::Approx(180.0));
+    CHECK(pr::rotation_angle(pr::Vector2{-3.f, 0.f}) == doctest::Approx(270.0));
+  }
+
+  SUBCASE("Null velocity:") {
+    const pr::Boid b1{pr::Vector2{1.f, 1.f}, pr::Vector2{}, 5.f, 180.f};
+
+    CHECK(b1.get_rotation_angle() == 0.f);
+  }
 }
 
 TEST_CASE("Testing the limit_velocity() method") {
@@ -443,4 +458,46 @@ TEST_CASE("Testing the operator==") {
 
     CHECK(same == false);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Testing the sees() method") {
+  SUBCASE("The same decisions of get_diff_angle():") {
+    // a deterministic spread of positions, velocities and view angles; the
+    // pairs within a thousandth of a degree of the border of the view could
+    // go either way, and are left out.
+    int compared{0};
+    int same{0};
+
+    for (int i{0}; i < 20000; ++i) {
+      const pr::Vector2 velocity{static_cast<float>(i % 13) - 6.5f,
+                                 static_cast<float>(i % 7) - 3.5f};
+      const pr::Vector2 other{static_cast<float>((i * 37) % 200) - 100.f,
+                              static_cast<float>((i * 91) % 160) - 80.f};
+      const float view_angle = static_cast<float>((i * 7) % 181);
+
+      const pr::Boid boid{pr::Vector2{}, velocity, 10.f, view_angle};
+      if (other == pr::Vector2{}) {
+        continue;
+      }
+
+      const float angle = boid.get_diff_angle(other);
+      if (std::abs(angle - view_angle) > 0.001f) {
+        ++compared;
+        same += boid.sees(other) == (angle <= view_angle) ? 1 : 0;
+      }
+    }
+
+    CHECK(compared > 19000);
+    CHECK(same == compared);
+  }
+
+  SUBCASE("The whole circle, and a view in a single direction:") {
+    const pr::Boid all_around{pr::Vector2{}, pr::Vector2{1.f, 0.f}, 10.f,
+                              180.f};
+    const pr::Boid straight{pr::Vector2{}, pr::Vector2{1.f, 0.f}, 10.f, 0.f};
+
+    CHECK(all_around.sees(pr::Vector2{-5.f, 0.f}) == true);
+    CHECK(straight.sees(pr::Vector2{5.f, 0.f}) == true);
+    CHECK(straight.sees(pr::Vector2{5.f, 1.f}) == false);
+  }
+}
@@ -0,0 +1,32 @@
+#include "fixed_step_clock.hpp"
+
+#include <cassert>
+
+namespace pr {
+Fixed_step_clock::Fixed_step_clock(double tick, std::size_t max_ticks)
+    : tick_{tick}, max_ticks_{max_ticks}, accumulator_{0.} {
+  assert(tick_ > 0. && max_ticks_ >= 1);
+}
+
+double Fixed_step_clock::tick() const { return tick_; }
+
+std::size_t Fixed_step_clock::advance(double elapsed) {
+  assert(elapsed >= 0.);
+  accumulator_ += elapsed;
+
+  std::size_t ticks{0};
+  while (accumulator_ >= tick_ && ticks < max_ticks_) {
+    accumulator_ -= tick_;
+    ++ticks;
+  }
+
+  if (accumulator_ >= tick_) {
+    accumulator_ = 0.;
+  }
+  assert(accumulator_ >= 0. && accumulator_ < tick_);
+
+  return ticks;
+}
+
+double Fixed_step_clock::alpha() const { return accumulator_ / tick_; }
+}  // namespace pr
@@ -0,0 +1,32 @@
+#ifndef FIXED_STEP_CLOCK_HPP
+#define FIXED_STEP_CLOCK_HPP
+
+#include <cstddef>
+
+namespace pr {
+// turns the real time passed between two frames into a number of updates of
+// constant length ("ticks"), so that the simulation doesn't depend on the
+// frame rate: the time left over is kept for the next frame.
+class Fixed_step_clock {
+  const double tick_;
+
+  const std::size_t max_ticks_;
+
+  double accumulator_;
+
+ public:
+  Fixed_step_clock(double tick, std::size_t max_ticks);
+
+  double tick() const;
+
+  // adds "elapsed" seconds and returns the number of ticks they complete,
+  // never more than max_ticks: the rest of a long hitch is dropped, so that
+  // the simulation slows down instead of falling further and further behind.
+  std::size_t advance(double elapsed);
+
+  // the part of the next tick already accumulated, in [0, 1).
+  double alpha() const;
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,44 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "fixed_step_clock.hpp"
+
+#include "doctest.h"
+
+TEST_CASE("Testing the advance() method") {
+  pr::Fixed_step_clock clock{0.01, 5};
+
+  SUBCASE("Less than a tick:") {
+    CHECK(clock.advance(0.004) == 0);
+    CHECK(clock.alpha() == doctest::Approx(0.4));
+  }
+
+  SUBCASE("The time left over is kept:") {
+    CHECK(clock.advance(0.025) == 2);
+    CHECK(clock.alpha() == doctest::Approx(0.5));
+    CHECK(clock.advance(0.006) == 1);
+    CHECK(clock.alpha() == doctest::Approx(0.1));
+  }
+
+  SUBCASE("A hitch is capped:") {
+    CHECK(clock.advance(1.) == 5);
+    CHECK(clock.alpha() == doctest::Approx(0.));
+    CHECK(clock.advance(0.012) == 1);
+  }
+
+  SUBCASE("The same time gives the same ticks, at any frame rate:") {
+    // durations which are exact in binary, so that no rounding gets in.
+    pr::Fixed_step_clock fast{1. / 64., 5};
+    pr::Fixed_step_clock slow{1. / 64., 5};
+    std::size_t fast_ticks{0};
+    std::size_t slow_ticks{0};
+
+    for (int frame{0}; frame < 128; ++frame) {
+      fast_ticks += fast.advance(1. / 128.);
+    }
+    for (int frame{0}; frame < 32; ++frame) {
+      slow_ticks += slow.advance(1. / 32.);
+    }
+
+    CHECK(fast_ticks == 64);
+    CHECK(slow_ticks == 64);
+  }
+}
@@ -2,10 +2,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <numeric>
+#include <utility>
 
 namespace pr {
+namespace {
+// the slot of the ids which don't belong to any boid.
+const std::size_t no_slot = static_cast<std::size_t>(-1);
+}  // namespace
+
+bool operator==(const Boid_handle& left, const Boid_handle& right) {
+  return left.id == right.id && left.generation == right.generation;
+}
+
+bool operator!=(const Boid_handle& left, const Boid_handle& right) {
+  return !(left == right);
+}
 
 float quadratic_difference(const std::vector<float>& generic_vector) {
   const float medium_value =
@@ -21,6 +35,11 @@ float quadratic_difference(const std::vector<float>& generic_vector) {
   return quadratic_difference;
 };
 
+double seconds_between(std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
 Flock::Flock(const float distance, const float ds_parameter,
              const float s_parameter, const float a_parameter,
              const float c_parameter)
@@ -28,7 +47,17 @@ Flock::Flock(const float distance, const float ds_parameter,
       distance_of_separation_{ds_parameter},
       separation_parameter_{s_parameter},
       allignment_parameter_{a_parameter},
-      cohesion_parameter_{c_parameter} {
+      cohesion_parameter_{c_parameter},
+      interactions_{Interaction_table::prey_and_predators()},
+      reorder_every_{0},
+      updates_since_reorder_{0},
+      grid_{distance},
+      neighbour_lists_ready_{false},
+      update_mode_{Update_mode::in_place},
+      timings_{0., 0., 0.},
+      statistics_mode_{Statistics_mode::exact},
+      distance_samples_{4096},
+      statistics_{std::make_unique<Statistics_scheduler>()} {
   assert(closeness_parameter_ >= 50.f && closeness_parameter_ <= 200.f &&
          distance_of_separation_ >= 25.f && distance_of_separation_ <= 40.f &&
          separation_parameter_ >= 0.005f && separation_parameter_ <= 0.08f &&
@@ -36,55 +65,243 @@ Flock::Flock(const float distance, const float ds_parameter,
          cohesion_parameter_ >= 0.0001f && cohesion_parameter_ <= 0.001f);
 };
 
-std::vector<Boid> Flock::all_boids() const { return boids_; };
+std::vector<Boid> Flock::all_boids() const {
+  std::vector<Boid> boids;
+  boids.reserve(boids_.size());
+
+  // in the order of the ids, whatever the order of the storage.
+  for (const std::size_t slot : slot_of_) {
+    if (slot != no_slot) {
+      boids.push_back(boids_.boid(slot));
+    }
+  }
+
+  return boids;
+};
+
+const Boid_store& Flock::boids() const { return boids_; }
 
 std::size_t Flock::size() const { return boids_.size(); }
 
 Boid Flock::single_boid(int number_of_boid) const {
-  return boids_[number_of_boid];
+  assert(number_of_boid >= 0 &&
+         static_cast<std::size_t>(number_of_boid) < slot_of_.size() &&
+         slot_of_[number_of_boid] != no_slot);
+
+  return boids_.boid(slot_of_[number_of_boid]);
 }
 
-void Flock::push_back(const Boid& new_boid) { boids_.push_back(new_boid); }
+Boid_view Flock::boid_view(std::size_t number_of_boid) const {
+  assert(number_of_boid < slot_of_.size() &&
+         slot_of_[number_of_boid] != no_slot);
 
-float Flock::close_boids_angle(const Boid& chosen_boid) const {
-  return count_if(boids_.begin(), boids_.end(),
-                  [this, &chosen_boid](const Boid& other_boid) {
-                    return chosen_boid.isNear(other_boid,
-                                              this->closeness_parameter_) ==
-                               true &&
-                           other_boid.isRed() == true;
-                  });
+  return boids_[slot_of_[number_of_boid]];
 }
 
-float Flock::close_boids_360(const Boid& chosen_boid) const {
-  return count_if(
-      boids_.begin(), boids_.end(),
-      [this, &chosen_boid](const Boid& other_boid) {
-        float distance = chosen_boid.position().distance(other_boid.position());
-        return distance < this->closeness_parameter_ && distance != 0.f;
+Boid Flock::single_boid(Boid_handle handle) const {
+  assert(contains(handle));
+
+  return boids_.boid(slot_of_[handle.id]);
+}
+
+Boid_view Flock::boid_view(Boid_handle handle) const {
+  assert(contains(handle));
+
+  return boids_[slot_of_[handle.id]];
+}
+
+std::size_t Flock::new_id(std::size_t slot) {
+  // the ids of the removed boids are given again, so that slot_of_ doesn't
+  // grow with the churn of the flock.
+  std::size_t id{slot_of_.size()};
+  if (free_ids_.empty()) {
+    slot_of_.push_back(no_slot);
+    generation_of_.push_back(0);
+
+  } else {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  }
+
+  slot_of_[id] = slot;
+
+  return id;
+}
+
+Boid_handle Flock::push_back(const Boid& new_boid) {
+  assert(interactions_.contains(new_boid.species()));
+
+  const std::size_t id = new_id(boids_.size());
+  boids_.push_back(new_boid, id);
+  grid_.push_back(new_boid.position());
+
+  return Boid_handle{id, generation_of_[id]};
+}
+
+void Flock::spawn(const Spawn_spec& spec, std::mt19937& engine) {
+  assert(interactions_.contains(spec.species) && spec.maximum_velocity > 0.f &&
+         spec.velocity_deviation >= 0.f && spec.min_view_angle >= 0.f &&
+         spec.min_view_angle <= spec.max_view_angle &&
+         spec.max_view_angle <= 180.f);
+
+  if (spec.count == 0) {
+    return;
+  }
+
+  // the capacity at least doubles, so that many small spawns stay linear.
+  const std::size_t count = boids_.size() + spec.count;
+  boids_.reserve(std::max(count, 2 * boids_.size()));
+  slot_of_.reserve(std::max(count, 2 * slot_of_.size()));
+  generation_of_.reserve(std::max(count, 2 * generation_of_.size()));
+
+  std::normal_distribution<float> velocity{0.f, spec.velocity_deviation};
+  std::uniform_real_distribution<float> view_angle{spec.min_view_angle,
+                                                   spec.max_view_angle};
+
+  for (std::size_t k{0}; k < spec.count; ++k) {
+    const Vector2 position = spec.area(engine);
+    const float velocity_x = velocity(engine);
+    const float velocity_y = velocity(engine);
+
+    boids_.emplace_back(position, Vector2{velocity_x, velocity_y},
+                        spec.maximum_velocity, view_angle(engine),
+                        spec.species, new_id(boids_.size()));
+  }
+
+  // a single rebuild, rather than displacing every new boid.
+  grid_.rebuild(boids_.size(),
+                [this](std::size_t i) { return boids_.position(i); });
+}
+
+bool Flock::remove(Boid_handle handle) {
+  if (contains(handle) == false) {
+    return false;
+  }
+
+  const std::size_t slot = slot_of_[handle.id];
+  const std::size_t moved_id = boids_.id(boids_.size() - 1);
+
+  boids_.swap_and_pop(slot);
+  grid_.swap_and_pop(slot);
+  slot_of_[moved_id] = slot;
+
+  slot_of_[handle.id] = no_slot;
+  ++generation_of_[handle.id];
+  free_ids_.push_back(handle.id);
+
+  // the lists point to the old indices.
+  if (neighbour_lists_) {
+    neighbour_lists_->clear();
+  }
+
+  return true;
+}
+
+bool Flock::contains(Boid_handle handle) const {
+  return handle.id < slot_of_.size() && slot_of_[handle.id] != no_slot &&
+         generation_of_[handle.id] == handle.generation;
+}
+
+Boid_handle Flock::handle_at(std::size_t index) const {
+  assert(index < boids_.size());
+  const std::size_t id = boids_.id(index);
+
+  return Boid_handle{id, generation_of_[id]};
+}
+
+void Flock::set_interactions(const Interaction_table& interactions) {
+  for (std::size_t i{0}; i < boids_.size(); ++i) {
+    assert(interactions.contains(boids_.species(i)));
+  }
+
+  interactions_ = interactions;
+}
+
+const Interaction_table& Flock::interactions() const { return interactions_; }
+
+float Flock::neighbourhood_radius() const {
+  return std::max(closeness_parameter_, distance_of_separation_);
+}
+
+template <typename For_each_candidate>
+Neighbourhood Flock::gather_neighbourhood(
+    const Boid& chosen_boid, For_each_candidate&& for_each_candidate) const {
+  Neighbourhood neighbourhood{0.f, 0.f, Vector2{}, 0.f, Vector2{}, Vector2{}};
+  const float squared_separation =
+      distance_of_separation_ * distance_of_separation_;
+  const float squared_closeness = closeness_parameter_ * closeness_parameter_;
+
+  for_each_candidate(
+      [this, &chosen_boid, &neighbourhood, squared_separation,
+       squared_closeness](std::size_t i) {
+        const Vector2 other_position = boids_.position(i);
+        const float squared_distance =
+            chosen_boid.position().squared_distance(other_position);
+
+        if (squared_distance == 0.f) {
+          return;
+        }
+
+        const Interaction& interaction =
+            interactions_(chosen_boid.species(), boids_.species(i));
+
+        if (squared_distance < squared_separation && interaction.separation) {
+          neighbourhood.separation += other_position - chosen_boid.position();
+        }
+
+        if (squared_distance < squared_closeness) {
+          ++neighbourhood.close_boids;
+
+          if ((interaction.cohesion || interaction.allignment) &&
+              chosen_boid.sees(other_position)) {
+            if (interaction.cohesion) {
+              ++neighbourhood.visible_boids;
+              neighbourhood.positions_sum += other_position;
+            }
+
+            if (interaction.allignment) {
+              ++neighbourhood.aligned_boids;
+              neighbourhood.relative_velocities_sum +=
+                  boids_.velocity(i) - chosen_boid.velocity();
+            }
+          }
+        }
       });
+  assert(neighbourhood.visible_boids <= neighbourhood.close_boids &&
+         neighbourhood.aligned_boids <= neighbourhood.close_boids);
+
+  return neighbourhood;
 }
 
-Vector2 Flock::find_centermass(const Boid& chosen_boid) const {
-  std::vector<Vector2> near_boids;
+Neighbourhood Flock::find_neighbourhood(const Boid& chosen_boid) const {
+  return gather_neighbourhood(chosen_boid,
+                              [this, &chosen_boid](const auto& visit) {
+                                grid_.for_each_candidate(
+                                    chosen_boid.position(),
+                                    neighbourhood_radius(), visit);
+                              });
+}
 
-  for (const Boid& other_boid : boids_) {
-    if (chosen_boid.isNear(other_boid, closeness_parameter_) == true &&
-        other_boid.isRed() == true) {
-      near_boids.push_back(other_boid.position());
-    }
-    assert(near_boids.size() <= boids_.size());
+Neighbourhood Flock::neighbourhood_of(std::size_t index,
+                                      const Boid& chosen_boid) const {
+  if (neighbour_lists_ready_ == true &&
+      neighbour_lists_->is_displaced(index) == false) {
+    return gather_neighbourhood(chosen_boid,
+                                [this, index](const auto& visit) {
+                                  neighbour_lists_->for_each_neighbour(index,
+                                                                       visit);
+                                });
+
+  } else {
+    return find_neighbourhood(chosen_boid);
   }
+}
 
-  if (!near_boids.empty()) {
+Vector2 Flock::centermass_of(const Boid& chosen_boid,
+                             const Neighbourhood& neighbourhood) const {
+  if (neighbourhood.visible_boids != 0.f) {
     const Vector2 mass_center =
-        std::accumulate(near_boids.begin(), near_boids.end(), Vector2{0.f, 0.f},
-                        [](const Vector2& a, const Vector2& b) {
-                          const Vector2 result = a + b;
-
-                          return result;
-                        }) *
-        (1.f / close_boids_angle(chosen_boid));
+        neighbourhood.positions_sum * (1.f / neighbourhood.visible_boids);
 
     return mass_center;
 
@@ -93,127 +310,188 @@ Vector2 Flock::find_centermass(const Boid& chosen_boid) const {
   }
 }
 
-Vector2 Flock::find_separation(const Boid& chosen_boid) const {
-  Vector2 null{};
+Vector2 Flock::separation_of(const Boid&,
+                             const Neighbourhood& neighbourhood) const {
+  return neighbourhood.separation * (-separation_parameter_);
+}
+
+Vector2 Flock::allignment_of(const Boid&,
+                             const Neighbourhood& neighbourhood) const {
+  if (neighbourhood.aligned_boids >= 1.f) {
+    return neighbourhood.relative_velocities_sum *
+           (allignment_parameter_ / neighbourhood.aligned_boids);
+
+  } else {
+    const Vector2 null{};
 
-  for (const Boid& other_boid : boids_) {
-    null += chosen_boid.separation(other_boid, separation_parameter_,
-                                   distance_of_separation_);
+    return null;
   }
+}
+
+Vector2 Flock::velocity_offset(const Boid& chosen_boid,
+                               const Neighbourhood& neighbourhood) const {
+  const Vector2 velocity_offset =
+      separation_of(chosen_boid, neighbourhood) +
+      allignment_of(chosen_boid, neighbourhood) +
+      chosen_boid.cohesion(centermass_of(chosen_boid, neighbourhood),
+                           cohesion_parameter_);
 
-  return null;
+  return velocity_offset;
 }
 
-Vector2 Flock::find_allignment(const Boid& chosen_boid) const {
-  Vector2 null{};
+float Flock::close_boids_angle(const Boid& chosen_boid) const {
+  return find_neighbourhood(chosen_boid).visible_boids;
+}
 
-  for (const Boid& other_boid : boids_) {
-    null += chosen_boid.allignment(other_boid, allignment_parameter_,
-                                   close_boids_angle(chosen_boid),
-                                   closeness_parameter_);
-  }
+float Flock::close_boids_360(const Boid& chosen_boid) const {
+  float close_boids{0.f};
+  const float squared_closeness = closeness_parameter_ * closeness_parameter_;
+
+  grid_.for_each_candidate(
+      chosen_boid.position(), closeness_parameter_,
+      [this, &chosen_boid, &close_boids, squared_closeness](std::size_t i) {
+        const float squared_distance =
+            chosen_boid.position().squared_distance(boids_.position(i));
+
+        if (squared_distance < squared_closeness && squared_distance != 0.f) {
+          ++close_boids;
+        }
+      });
 
-  return null;
+  return close_boids;
 }
 
-Vector2 Flock::find_cohesion(const Boid& chosen_boid) const {
-  const Vector2 velocity_offset =
-      find_separation(chosen_boid) + find_allignment(chosen_boid) +
-      chosen_boid.cohesion(find_centermass(chosen_boid), cohesion_parameter_);
+Vector2 Flock::find_centermass(const Boid& chosen_boid) const {
+  return centermass_of(chosen_boid, find_neighbourhood(chosen_boid));
+}
 
-  return velocity_offset;
+Vector2 Flock::find_separation(const Boid& chosen_boid) const {
+  return separation_of(chosen_boid, find_neighbourhood(chosen_boid));
 }
 
-bool Flock::is_predator(const Boid& chosen_boid) const {
-  if (chosen_boid.isRed() == true) {
-    const float predator_distance = 300.f;
+Vector2 Flock::find_allignment(const Boid& chosen_boid) const {
+  return allignment_of(chosen_boid, find_neighbourhood(chosen_boid));
+}
 
-    return std::any_of(
-        boids_.begin(), boids_.end(),
-        [predator_distance, &chosen_boid](const Boid& other_boid) {
-          const float distance =
-              chosen_boid.position().distance(other_boid.position());
+Vector2 Flock::find_cohesion(const Boid& chosen_boid) const {
+  return velocity_offset(chosen_boid, find_neighbourhood(chosen_boid));
+}
 
-          return other_boid.isRed() == false && distance < predator_distance &&
-                 distance != 0;
+bool Flock::is_predator(const Boid& chosen_boid) const {
+  if (interactions_.flees_any(chosen_boid.species())) {
+    const float predator_distance = 300.f;
+    bool predator_found{false};
+
+    grid_.for_each_candidate(
+        chosen_boid.position(), predator_distance,
+        [this, predator_distance, &chosen_boid,
+         &predator_found](std::size_t i) {
+          const float squared_distance =
+              chosen_boid.position().squared_distance(boids_.position(i));
+
+          if (interactions_(chosen_boid.species(), boids_.species(i)).flight &&
+              squared_distance < predator_distance * predator_distance &&
+              squared_distance != 0.f) {
+            predator_found = true;
+          }
         });
 
+    return predator_found;
+
   } else {
     return false;
   }
 }
 
-void Flock::in_limits(Boid& chosen_boid, unsigned int window_height,
-                      unsigned int window_width) {
-  const float max_height = static_cast<float>(window_height);
-  const float max_width = static_cast<float>(window_width);
+bool Flock::out_of_limits(const Vector2& position, float max_height,
+                          float max_width) {
+  return position.x_axis() >= max_height || position.x_axis() <= 0.f ||
+         position.y_axis() >= max_width || position.y_axis() <= 0.f;
+}
 
-  if (is_predator(chosen_boid) == false) {
-    for (Boid& other_boid : boids_) {
-      if (other_boid.position().distance(chosen_boid.position()) <
-          closeness_parameter_) {
-        if (chosen_boid.get_shape().getPosition().x >= max_height) {
-          other_boid.change_velocity(
-              Vector2{-std::abs(2.f * other_boid.velocity().x_axis()), 0.f});
-          assert(other_boid.velocity().x_axis() <= 0.f);
-        }
+Vector2 Flock::bounce_offset(const Vector2& chosen_position,
+                             const Vector2& velocity, float max_height,
+                             float max_width) const {
+  Vector2 velocity_offset{};
 
-        if (chosen_boid.get_shape().getPosition().x <= 0.f) {
-          other_boid.change_velocity(
-              Vector2{std::abs(2.0f * other_boid.velocity().x_axis()), 0.f});
-          assert(other_boid.velocity().x_axis() >= 0.f);
-        }
+  // the components which go further out of the window are reflected, the
+  // ones which already point back inside are kept.
+  if (chosen_position.x_axis() >= max_height && velocity.x_axis() > 0.f) {
+    velocity_offset += Vector2{-2.f * velocity.x_axis(), 0.f};
+  }
 
-        if (chosen_boid.get_shape().getPosition().y >= max_width) {
-          other_boid.change_velocity(
-              Vector2{0.f, -std::abs(2.f * other_boid.velocity().y_axis())});
-          assert(other_boid.velocity().y_axis() <= 0.f);
-        }
+  if (chosen_position.x_axis() <= 0.f && velocity.x_axis() < 0.f) {
+    velocity_offset += Vector2{-2.f * velocity.x_axis(), 0.f};
+  }
 
-        if (chosen_boid.get_shape().getPosition().y <= 0.f) {
-          other_boid.change_velocity(
-              Vector2{0.f, std::abs(2.0f * other_boid.velocity().y_axis())});
-          assert(other_boid.velocity().y_axis() >= 0.f);
-        }
-      }
-    }
+  if (chosen_position.y_axis() >= max_width && velocity.y_axis() > 0.f) {
+    velocity_offset += Vector2{0.f, -2.f * velocity.y_axis()};
+  }
 
-  } else {
-    if (chosen_boid.get_shape().getPosition().x > max_height) {
-      chosen_boid.change_position(Vector2{-max_height, 0.f});
-      chosen_boid.set_shape().setPosition(
-          sf::Vector2f{0.f, chosen_boid.position().y_axis()});
-    }
+  if (chosen_position.y_axis() <= 0.f && velocity.y_axis() < 0.f) {
+    velocity_offset += Vector2{0.f, -2.f * velocity.y_axis()};
+  }
 
-    if (chosen_boid.get_shape().getPosition().x < 0.f) {
-      chosen_boid.change_position(Vector2{max_height, 0.f});
-      chosen_boid.set_shape().setPosition(
-          sf::Vector2f{max_height, chosen_boid.position().y_axis()});
-    }
+  return velocity_offset;
+}
 
-    if (chosen_boid.get_shape().getPosition().y > max_width) {
-      chosen_boid.change_position(Vector2{0.f, -max_width});
-      chosen_boid.set_shape().setPosition(
-          sf::Vector2f{chosen_boid.position().x_axis(), 0.f});
-    }
+void Flock::wrap_around(Boid& chosen_boid, float max_height,
+                        float max_width) const {
+  const Vector2 position = chosen_boid.position();
 
-    if (chosen_boid.get_shape().getPosition().y < 0.f) {
-      chosen_boid.change_position(Vector2{0.f, max_width});
-      chosen_boid.set_shape().setPosition(
-          sf::Vector2f{chosen_boid.position().x_axis(), max_width});
-    }
+  if (position.x_axis() > max_height) {
+    chosen_boid.change_position(Vector2{-max_height, 0.f});
+  }
+
+  if (position.x_axis() < 0.f) {
+    chosen_boid.change_position(Vector2{max_height, 0.f});
+  }
+
+  if (position.y_axis() > max_width) {
+    chosen_boid.change_position(Vector2{0.f, -max_width});
+  }
+
+  if (position.y_axis() < 0.f) {
+    chosen_boid.change_position(Vector2{0.f, max_width});
+  }
+}
+
+void Flock::keep_in_limits(Boid& chosen_boid, bool chased, float max_height,
+                           float max_width) const {
+  if (chased == true) {
+    wrap_around(chosen_boid, max_height, max_width);
+
+  } else {
+    chosen_boid.change_velocity(bounce_offset(
+        chosen_boid.position(), chosen_boid.velocity(), max_height, max_width));
+  }
+}
+
+void Flock::in_limits(Boid& chosen_boid, unsigned int window_height,
+                      unsigned int window_width) const {
+  const float max_height = static_cast<float>(window_height);
+  const float max_width = static_cast<float>(window_width);
+
+  // is_predator() is a query of the grid: it is left to the few boids which
+  // are out of the window.
+  if (out_of_limits(chosen_boid.position(), max_height, max_width) == true) {
+    keep_in_limits(chosen_boid, is_predator(chosen_boid), max_height,
+                   max_width);
   }
 }
 
-Vector2 Flock::evolve(Boid& chosen_boid, float delta_time) {
-  if (close_boids_360(chosen_boid) != 0.f) {
-    chosen_boid.change_velocity(find_cohesion(chosen_boid));
+Vector2 Flock::evolve(Boid& chosen_boid, float delta_time) const {
+  return evolve(chosen_boid, find_neighbourhood(chosen_boid), delta_time);
+}
+
+Vector2 Flock::evolve(Boid& chosen_boid, const Neighbourhood& neighbourhood,
+                      float delta_time) const {
+  if (neighbourhood.close_boids != 0.f) {
+    chosen_boid.change_velocity(velocity_offset(chosen_boid, neighbourhood));
 
     const Vector2 position_offset = chosen_boid.velocity() * delta_time;
     chosen_boid.change_position(position_offset);
 
-    chosen_boid.setRotation();
-
     return position_offset;
 
   } else {
@@ -226,9 +504,10 @@ Vector2 Flock::evolve(Boid& chosen_boid, float delta_time) {
 
 std::vector<float> Flock::extract_velocities() const {
   std::vector<float> velocities;
+  velocities.reserve(boids_.size());
 
-  for (const Boid& boid : boids_) {
-    velocities.push_back(boid.velocity().lenght_of_vector());
+  for (std::size_t i{0}; i < boids_.size(); ++i) {
+    velocities.push_back(boids_.velocity(i).lenght_of_vector());
   }
   assert(velocities.size() == boids_.size());
 
@@ -237,14 +516,11 @@ std::vector<float> Flock::extract_velocities() const {
 
 std::vector<float> Flock::extract_distances() const {
   std::vector<float> distances;
+  distances.reserve(boids_.size() * (boids_.size() - 1) / 2);
 
-  for (const Boid& boid : boids_) {
-    auto boid_position = std::find(boids_.begin(), boids_.end(), boid);
-    std::size_t number_of_boid = std::distance(boids_.begin(), boid_position);
-
-    for (std::size_t i{number_of_boid + 1}; i < boids_.size(); ++i) {
-      const float distance =
-          boid.position().distance(single_boid(i).position());
+  for (std::size_t j{0}; j < boids_.size(); ++j) {
+    for (std::size_t i{j + 1}; i < boids_.size(); ++i) {
+      const float distance = boids_.position(j).distance(boids_.position(i));
       distances.push_back(distance);
     }
   }
@@ -254,52 +530,288 @@ std::vector<float> Flock::extract_distances() const {
 }
 
 Simulation_state Flock::state() const {
-  if (boids_.size() > 2) {
-    const std::vector<float> velocities = extract_velocities();
-    const std::vector<float> distances = extract_distances();
+  return state_of(boids_, statistics_mode_, distance_samples_,
+                  sampling_engine_);
+}
+
+void Flock::set_statistics_mode(Statistics_mode mode,
+                                std::size_t distance_samples) {
+  assert(distance_samples >= 2);
 
-    const float medium_velocity =
-        (std::accumulate(velocities.begin(), velocities.end(), 0.f)) /
-        velocities.size();
+  statistics_mode_ = mode;
+  distance_samples_ = distance_samples;
+  statistics_->set_mode(mode, distance_samples);
+}
 
-    const float quadratic_difference_v = quadratic_difference(velocities);
+Statistics_mode Flock::statistics_mode() const { return statistics_mode_; }
 
-    const float err_velocity =
-        std::sqrt((1.f / ((velocities.size() - 1) * velocities.size())) *
-                  quadratic_difference_v);
+void Flock::set_statistics_cadence(std::size_t every_updates,
+                                   float every_seconds, bool background) {
+  statistics_->set_cadence(every_updates, every_seconds);
+  statistics_->set_background(background);
+}
 
-    const float medium_distance =
-        (std::accumulate(distances.begin(), distances.end(), 0.f)) /
-        distances.size();
+Simulation_state Flock::latest_state() const { return statistics_->latest(); }
 
-    const float quadratic_difference_p = quadratic_difference(distances);
+std::size_t Flock::computed_states() const { return statistics_->results(); }
 
-    const float err_distance =
-        std::sqrt((1.f / ((distances.size() - 1) * distances.size())) *
-                  quadratic_difference_p);
+void Flock::set_neighbour_skin(float skin) {
+  assert(skin >= 0.f);
 
-    return {medium_velocity, err_velocity, medium_distance, err_distance};
+  if (skin > 0.f) {
+    neighbour_lists_ = std::make_unique<Neighbour_list>(skin);
 
   } else {
-    return {0.f, 0.f, 0.f, 0.f};
+    neighbour_lists_.reset();
   }
+  neighbour_lists_ready_ = false;
 }
 
-void Flock::update(sf::Time const& time, unsigned int window_height,
-                   unsigned int window_width) {
-  for (Boid& boid : boids_) {
-    boid.limit_velocity();
-    boid.setRotation();
+float Flock::neighbour_skin() const {
+  return neighbour_lists_ ? neighbour_lists_->skin() : 0.f;
+}
+
+std::size_t Flock::neighbour_list_rebuilds() const {
+  return neighbour_lists_ ? neighbour_lists_->rebuilds() : 0;
+}
+
+void Flock::prepare_neighbour_lists() {
+  neighbour_lists_ready_ = false;
+
+  if (neighbour_lists_) {
+    const auto position_of = [this](std::size_t i) {
+      return boids_.position(i);
+    };
 
-    const float delta_time = time.asSeconds() * 210.f;
+    if (neighbour_lists_->refresh(boids_.size(), neighbourhood_radius(),
+                                  position_of) == false) {
+      neighbour_lists_->rebuild(grid_, boids_.size(), neighbourhood_radius(),
+                                position_of);
+    }
+    neighbour_lists_ready_ = true;
+  }
+}
+
+void Flock::set_reordering(std::size_t every_updates) {
+  reorder_every_ = every_updates;
+  updates_since_reorder_ = 0;
+}
+
+std::size_t Flock::reordering() const { return reorder_every_; }
 
-    Vector2 position_offset = evolve(boid, delta_time);
+void Flock::reorder_by_position() {
+  const std::size_t count = boids_.size();
+  if (count == 0) {
+    return;
+  }
 
+  float min_x = boids_.position(0).x_axis();
+  float min_y = boids_.position(0).y_axis();
+  for (std::size_t i{1}; i < count; ++i) {
+    min_x = std::min(min_x, boids_.position(i).x_axis());
+    min_y = std::min(min_y, boids_.position(i).y_axis());
+  }
+
+  // the cells of the grid: the boids of a cell stay together, and the cells
+  // close to each other end up close in the storage.
+  const auto cell_of = [this](float coordinate) {
+    const float cell = std::floor(coordinate / grid_.cell_size());
+
+    return static_cast<std::uint16_t>(std::clamp(cell, 0.f, 65535.f));
+  };
+
+  // the index in the low bits breaks the ties, so the sort is stable.
+  assert(count <= 0xffffffffu);
+  morton_keys_.resize(count);
+  for (std::size_t i{0}; i < count; ++i) {
+    const Vector2 position = boids_.position(i);
+    const std::uint32_t code = morton_code(cell_of(position.x_axis() - min_x),
+                                           cell_of(position.y_axis() - min_y));
+
+    morton_keys_[i] = (static_cast<std::uint64_t>(code) << 32) | i;
+  }
+  std::sort(morton_keys_.begin(), morton_keys_.end());
+
+  morton_order_.resize(count);
+  for (std::size_t i{0}; i < count; ++i) {
+    morton_order_[i] = static_cast<std::size_t>(morton_keys_[i] & 0xffffffffu);
+  }
+
+  next_boids_.gather(boids_, morton_order_);
+  std::swap(boids_, next_boids_);
+
+  for (std::size_t i{0}; i < count; ++i) {
+    slot_of_[boids_.id(i)] = i;
+  }
+
+  // the lists point to the old indices.
+  if (neighbour_lists_) {
+    neighbour_lists_->clear();
+  }
+}
+
+void Flock::set_update_mode(Update_mode mode) { update_mode_ = mode; }
+
+Update_mode Flock::update_mode() const { return update_mode_; }
+
+void Flock::set_thread_count(unsigned int thread_count) {
+  assert(thread_count >= 1);
+
+  if (thread_count == 1) {
+    thread_pool_.reset();
+
+  } else {
+    thread_pool_ = std::make_unique<Thread_pool>(thread_count);
+  }
+}
+
+unsigned int Flock::thread_count() const {
+  return thread_pool_ ? thread_pool_->thread_count() : 1;
+}
+
+void Flock::update_in_place(float delta_time, unsigned int window_height,
+                            unsigned int window_width) {
+  const auto start = std::chrono::steady_clock::now();
+
+  grid_.rebuild(boids_.size(),
+                [this](std::size_t i) { return boids_.position(i); });
+  prepare_neighbour_lists();
+
+  const auto indexed = std::chrono::steady_clock::now();
+
+  for (std::size_t i{0}; i < boids_.size(); ++i) {
+    Boid boid = boids_.boid(i);
+
+    boid.limit_velocity();
+
+    evolve(boid, neighbourhood_of(i, boid), delta_time);
     in_limits(boid, window_height, window_width);
 
-    const sf::Vector2f graphic_offset{position_offset.x_axis(),
-                                      position_offset.y_axis()};
-    boid.set_shape().move(graphic_offset);
+    boids_.set_boid(i, boid);
+    grid_.relocate(i, boid.position());
+
+    // the next boids see this one where it moved: once it is too far from
+    // where the lists were built, it has to be displaced. Past the limit of
+    // the lists the rest of the sweep searches the grid, and the next update
+    // rebuilds them.
+    if (neighbour_lists_ready_ == true &&
+        neighbour_lists_->still_valid(i, boid.position()) == false) {
+      neighbour_lists_->displace(i);
+
+      if (neighbour_lists_->too_many_displaced() == true) {
+        neighbour_lists_ready_ = false;
+      }
+    }
   }
+
+  // rules and limits are applied boid by boid, so they can't be told apart.
+  const auto evolved = std::chrono::steady_clock::now();
+  timings_ = {seconds_between(start, indexed),
+              seconds_between(indexed, evolved), 0.};
 }
+
+void Flock::update_double_buffered(float delta_time,
+                                   unsigned int window_height,
+                                   unsigned int window_width) {
+  const float max_height = static_cast<float>(window_height);
+  const float max_width = static_cast<float>(window_width);
+
+  // first sweep: every boid follows the three rules, looking at the flock as
+  // it was at the beginning of the step.
+  const auto start = std::chrono::steady_clock::now();
+
+  grid_.rebuild(boids_.size(),
+                [this](std::size_t i) { return boids_.position(i); });
+  prepare_neighbour_lists();
+  next_boids_ = boids_;
+
+  const auto indexed = std::chrono::steady_clock::now();
+
+  parallel_for(boids_.size(), [this, delta_time](std::size_t begin,
+                                                 std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      Boid boid = boids_.boid(i);
+
+      boid.limit_velocity();
+      evolve(boid, neighbourhood_of(i, boid), delta_time);
+
+      next_boids_.set_boid(i, boid);
+    }
+  });
+  std::swap(boids_, next_boids_);
+
+  // second sweep: the limits of the window, which only look at the boid they
+  // move. A boid out of the window which is chased goes through the border,
+  // the others bounce back; whether it is chased is decided on the moved
+  // flock before any of them goes through.
+  const auto evolved = std::chrono::steady_clock::now();
+
+  grid_.rebuild(boids_.size(),
+                [this](std::size_t i) { return boids_.position(i); });
+
+  const auto reindexed = std::chrono::steady_clock::now();
+
+  is_chased_.resize(boids_.size());
+  parallel_for(boids_.size(), [this, max_height, max_width](
+                                  std::size_t begin, std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      is_chased_[i] =
+          out_of_limits(boids_.position(i), max_height, max_width) == true &&
+                  is_predator(boids_.boid(i)) == true
+              ? 1
+              : 0;
+    }
+  });
+
+  parallel_for(boids_.size(), [this, max_height, max_width](
+                                  std::size_t begin, std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      if (out_of_limits(boids_.position(i), max_height, max_width) == true) {
+        Boid boid = boids_.boid(i);
+        keep_in_limits(boid, is_chased_[i] == 1, max_height, max_width);
+
+        boids_.set_boid(i, boid);
+      }
+    }
+  });
+
+  // the boids which went through the border have to be found by the queries
+  // made before the next update.
+  for (std::size_t i{0}; i < boids_.size(); ++i) {
+    if (is_chased_[i] == 1) {
+      grid_.relocate(i, boids_.position(i));
+    }
+  }
+
+  const auto bounded = std::chrono::steady_clock::now();
+  timings_ = {seconds_between(start, indexed) +
+                  seconds_between(evolved, reindexed),
+              seconds_between(indexed, evolved),
+              seconds_between(reindexed, bounded)};
+}
+
+void Flock::update(float time, unsigned int window_height,
+                   unsigned int window_width) {
+  const float delta_time = time * 210.f;
+
+  const auto start = std::chrono::steady_clock::now();
+  if (reorder_every_ != 0 && ++updates_since_reorder_ >= reorder_every_) {
+    reorder_by_position();
+    updates_since_reorder_ = 0;
+  }
+  const double reordering =
+      seconds_between(start, std::chrono::steady_clock::now());
+
+  if (update_mode_ == Update_mode::double_buffered) {
+    update_double_buffered(delta_time, window_height, window_width);
+
+  } else {
+    update_in_place(delta_time, window_height, window_width);
+  }
+  timings_.index += reordering;  // the reordering is part of the indexing.
+
+  statistics_->on_update(boids_, time);
+}
+
+const Update_timings& Flock::last_update_timings() const { return timings_; }
 }  // namespace pr
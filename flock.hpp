@@ -1,21 +1,79 @@
 #ifndef FLOCK_HPP
 #define FLOCK_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <vector>
 
-#include "boid.hpp"
+#include "boid_store.hpp"
+#include "neighbour_list.hpp"
+#include "spatial_grid.hpp"
+#include "spawn.hpp"
+#include "statistics.hpp"
+#include "statistics_scheduler.hpp"
+#include "thread_pool.hpp"
 
 namespace pr {
 
-struct Simulation_state {
-  float medium_velocity;
-  float err_velocity;
-  float medium_distance;
-  float err_distance;
+// everything the three rules need to know about the boids around a chosen
+// one, collected by Flock::find_neighbourhood() with a single visit of each
+// candidate neighbour.
+struct Neighbourhood {
+  float close_boids;  // boids closer than closeness_parameter_, at any angle.
+
+  float visible_boids;  // boids near the chosen one, inside its view, which
+                        // it is attracted to (cohesion).
+
+  Vector2 positions_sum;  // of the visible boids.
+
+  float aligned_boids;  // boids near the chosen one, inside its view, whose
+                        // velocity it matches (allignment).
+
+  Vector2 relative_velocities_sum;  // of the aligned boids.
+
+  Vector2 separation;  // sum of the relative positions of the boids closer
+                       // than distance_of_separation_ it keeps away from.
+};
+
+// in_place: every boid is moved as soon as it is evolved, so the boids
+// evolved after it already see it in its new state (the original behaviour).
+// double_buffered: every boid is evolved against the state of the flock at
+// the beginning of the step, which is written into a second buffer and
+// swapped in at the end: the result doesn't depend on the order of the boids.
+enum class Update_mode { in_place, double_buffered };
+
+// a boid of a flock, which stays the same when the storage is reordered or
+// other boids are removed. Once the boid is removed its id can go to a new
+// boid, but with the next generation: the old handle doesn't see it.
+struct Boid_handle {
+  std::size_t id;
+
+  std::uint32_t generation;
+};
+
+bool operator==(const Boid_handle& left, const Boid_handle& right);
+
+bool operator!=(const Boid_handle& left, const Boid_handle& right);
+
+// time spent by the last Flock::update() in each of its phases, in seconds.
+struct Update_timings {
+  double index;  // rebuilding the spatial grid (and the neighbour lists, and
+                 // reordering the storage, when they are used).
+
+  double rules;  // finding the neighbours of every boid, then separation,
+                 // allignment, cohesion and the new positions.
+
+  double limits;  // the limits of the window (in the in_place mode they are
+                  // applied together with the rules, and counted there).
 };
 
 float quadratic_difference(const std::vector<float>& generic_vector);
 
+double seconds_between(std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end);
+
 class Flock {
   const float closeness_parameter_;
 
@@ -27,19 +85,167 @@ class Flock {
 
   const float cohesion_parameter_;
 
-  std::vector<Boid> boids_;
+  Interaction_table interactions_;
+
+  Boid_store boids_;
+
+  Boid_store next_boids_;  // back buffer of the double_buffered update.
+
+  std::vector<std::size_t> slot_of_;  // the index in boids_ of every id.
+
+  std::vector<std::uint32_t> generation_of_;  // the generation of every id.
+
+  std::vector<std::size_t> free_ids_;  // the ids of the removed boids.
+
+  std::size_t reorder_every_;  // 0 if the storage is never reordered.
+
+  std::size_t updates_since_reorder_;
+
+  std::vector<std::uint64_t> morton_keys_;  // buffers of the reordering.
+
+  std::vector<std::size_t> morton_order_;
+
+  std::vector<unsigned char> is_chased_;
+
+  Spatial_grid grid_;  // index of boids_ by position, rebuilt by update().
+
+  std::unique_ptr<Neighbour_list> neighbour_lists_;  // null without a skin.
+
+  bool neighbour_lists_ready_;  // whether the rules of the current update
+                                // can use neighbour_lists_.
+
+  Update_mode update_mode_;
+
+  std::unique_ptr<Thread_pool> thread_pool_;  // null when single threaded.
+
+  Update_timings timings_;
+
+  Statistics_mode statistics_mode_;
+
+  std::size_t distance_samples_;
+
+  // random pairs of the sampled statistics: state() is const, but two
+  // threads can't call it on the same flock at the same time.
+  mutable std::mt19937 sampling_engine_;
+
+  // the statistics computed by update(), behind a pointer so that the flock
+  // can still be moved.
+  std::unique_ptr<Statistics_scheduler> statistics_;
+
+  float neighbourhood_radius() const;
+
+  // the neighbourhood of the chosen boid among the boids given by
+  // "for_each_candidate(visit)", which calls "visit(i)" for each of them.
+  template <typename For_each_candidate>
+  Neighbourhood gather_neighbourhood(
+      const Boid& chosen_boid, For_each_candidate&& for_each_candidate) const;
+
+  // the neighbourhood of the index-th boid of boids_ ("chosen_boid"), from
+  // the neighbour lists when they are ready.
+  Neighbourhood neighbourhood_of(std::size_t index,
+                                 const Boid& chosen_boid) const;
+
+  Vector2 centermass_of(const Boid& chosen_boid,
+                        const Neighbourhood& neighbourhood) const;
+
+  Vector2 separation_of(const Boid& chosen_boid,
+                        const Neighbourhood& neighbourhood) const;
+
+  Vector2 allignment_of(const Boid& chosen_boid,
+                        const Neighbourhood& neighbourhood) const;
+
+  static bool out_of_limits(const Vector2& position, float max_height,
+                            float max_width);
+
+  Vector2 bounce_offset(const Vector2& chosen_position, const Vector2& velocity,
+                        float max_height, float max_width) const;
+
+  void wrap_around(Boid& chosen_boid, float max_height, float max_width) const;
+
+  // a chased boid goes through the border, the others bounce back.
+  void keep_in_limits(Boid& chosen_boid, bool chased, float max_height,
+                      float max_width) const;
+
+  template <typename Task>
+  void parallel_for(std::size_t count, const Task& task) {
+    if (thread_pool_) {
+      thread_pool_->parallel_for(count, task);
+
+    } else if (count != 0) {
+      task(0, count);
+    }
+  }
+
+  Vector2 evolve(Boid& chosen_boid, const Neighbourhood& neighbourhood,
+                 float delta_time) const;
+
+  // displaces the boids which moved too far since the neighbour lists were
+  // built, and rebuilds them if there are too many: grid_ has to index boids_.
+  void prepare_neighbour_lists();
+
+  // an id for a new boid, which is given the index "slot" of boids_.
+  std::size_t new_id(std::size_t slot);
+
+  // sorts boids_ along the Morton curve of their grid cells.
+  void reorder_by_position();
+
+  void update_in_place(float delta_time, unsigned int window_height,
+                       unsigned int window_width);
+
+  void update_double_buffered(float delta_time, unsigned int window_height,
+                              unsigned int window_width);
 
  public:
   Flock(const float distance, const float ds_parameter, const float s_parameter,
         const float a_parameter, const float c_parameter);
 
+  // a copy of every boid: boids() is the way to look at the flock.
   std::vector<Boid> all_boids() const;
 
+  // read-only access to the storage of the flock, valid as long as the flock
+  // (update() changes the boids it shows, never the reference). The order of
+  // the storage changes when it is reordered: Boid_view::id() doesn't.
+  const Boid_store& boids() const;
+
   std::size_t size() const;
 
+  // "number_of_boid" is the id of the boid: until a boid is removed, the
+  // order of push_back().
   Boid single_boid(int number_of_boid) const;
 
-  void push_back(const Boid& new_boid);
+  Boid_view boid_view(std::size_t number_of_boid) const;
+
+  // the handle has to be contained in the flock.
+  Boid single_boid(Boid_handle handle) const;
+
+  Boid_view boid_view(Boid_handle handle) const;
+
+  // the species of the new boid has to be in interactions().
+  Boid_handle push_back(const Boid& new_boid);
+
+  // adds all the boids of "spec" at once, drawing them with "engine", at the
+  // end of boids(): handle_at() gives their handles.
+  void spawn(const Spawn_spec& spec, std::mt19937& engine);
+
+  // removes the boid in O(1), moving the last one of boids() to its place,
+  // and returns false if it was already removed.
+  bool remove(Boid_handle handle);
+
+  bool contains(Boid_handle handle) const;
+
+  // the handle of the boid at "index" of boids().
+  Boid_handle handle_at(std::size_t index) const;
+
+  // how the species of the flock react to each other: by default prey and
+  // predators (see default_interaction()).
+  void set_interactions(const Interaction_table& interactions);
+
+  const Interaction_table& interactions() const;
+
+  Neighbourhood find_neighbourhood(const Boid& chosen_boid) const;
+
+  Vector2 velocity_offset(const Boid& chosen_boid,
+                          const Neighbourhood& neighbourhood) const;
 
   float close_boids_angle(const Boid& chosen_boid) const;
 
@@ -55,10 +261,12 @@ class Flock {
 
   bool is_predator(const Boid& chosen_boid) const;
 
+  // keeps the chosen boid in the window, looking only at its own position:
+  // the other boids are never changed.
   void in_limits(Boid& chosen_boid, unsigned int window_height,
-                 unsigned int window_width);
+                 unsigned int window_width) const;
 
-  Vector2 evolve(Boid& chosen_boid, float delta_time);
+  Vector2 evolve(Boid& chosen_boid, float delta_time) const;
 
   std::vector<float> extract_velocities() const;
 
@@ -66,8 +274,56 @@ class Flock {
 
   Simulation_state state() const;
 
-  void update(sf::Time const& time, unsigned int window_height,
+  void set_statistics_mode(Statistics_mode mode,
+                           std::size_t distance_samples = 4096);
+
+  Statistics_mode statistics_mode() const;
+
+  // makes update() compute the statistics every "every_updates" updates
+  // and/or every "every_seconds" seconds of simulation (0 turns off either;
+  // by default update() doesn't compute them at all), optionally on a
+  // background thread.
+  void set_statistics_cadence(std::size_t every_updates, float every_seconds,
+                              bool background = false);
+
+  // the latest statistics computed by update(), and how many were computed.
+  Simulation_state latest_state() const;
+
+  std::size_t computed_states() const;
+
+  // with a positive "skin", update() finds the neighbours of the rules in
+  // Verlet lists of radius closeness + skin, which are rebuilt only when a
+  // boid moved more than half the skin; 0 (the default) searches the grid
+  // at every update.
+  void set_neighbour_skin(float skin);
+
+  float neighbour_skin() const;
+
+  // how many times update() built the neighbour lists.
+  std::size_t neighbour_list_rebuilds() const;
+
+  // every "every_updates" updates (0, the default, never) update() sorts the
+  // storage of the boids along a Morton curve of their positions, so that
+  // the boids close in the window are close in memory as well.
+  void set_reordering(std::size_t every_updates);
+
+  std::size_t reordering() const;
+
+  void set_update_mode(Update_mode mode);
+
+  Update_mode update_mode() const;
+
+  // number of threads which share the double_buffered update (the in_place
+  // one is sequential by definition).
+  void set_thread_count(unsigned int thread_count);
+
+  unsigned int thread_count() const;
+
+  // "time" is the real time passed since the previous update, in seconds.
+  void update(float time, unsigned int window_height,
               unsigned int window_width);
+
+  const Update_timings& last_update_timings() const;
 };
 }  // namespace pr
 
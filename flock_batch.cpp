@@ -0,0 +1,77 @@
+// runs a scenario without a window, one step after the other as fast as the
+// flock can be updated: the statistics and the final boids are written where
+// the scenario says, so that the runs of the same scenario can be compared.
+//
+// usage: flock_batch [--scenario FILE] [--key value]...
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "scenario.hpp"
+
+int main(int argc, char* argv[]) {
+  pr::Scenario scenario;
+  std::string error;
+
+  if (!pr::parse_arguments(argc, argv, scenario, error)) {
+    std::cerr << error << '\n';
+    return 1;
+  }
+  if (scenario.steps == 0 || scenario.world_width == 0 ||
+      scenario.world_height == 0) {
+    std::cerr << "a run without a window needs steps, width and height\n";
+    return 1;
+  }
+
+  std::ofstream statistics_file;
+  if (!scenario.statistics_output.empty()) {
+    statistics_file.open(scenario.statistics_output);
+    if (!statistics_file) {
+      std::cerr << "can't write " << scenario.statistics_output << '\n';
+      return 1;
+    }
+  }
+  std::ostream& statistics =
+      scenario.statistics_output.empty() ? std::cout : statistics_file;
+
+  std::mt19937 engine{scenario.seed};
+  pr::Flock flock = pr::make_flock(scenario, engine);
+
+  if (scenario.statistics_every != 0) {
+    pr::write_statistics_header(statistics);
+  }
+
+  const float time_step = static_cast<float>(scenario.time_step);
+  double update_seconds{0.};
+
+  for (std::size_t step{1}; step <= scenario.steps; ++step) {
+    const auto start = std::chrono::steady_clock::now();
+    flock.update(time_step, scenario.world_width, scenario.world_height);
+    update_seconds +=
+        pr::seconds_between(start, std::chrono::steady_clock::now());
+
+    if (scenario.statistics_every != 0 &&
+        step % scenario.statistics_every == 0 && flock.size() >= 2) {
+      pr::write_statistics(statistics, step, flock.state());
+    }
+  }
+
+  if (!scenario.final_state_output.empty()) {
+    std::ofstream final_state{scenario.final_state_output};
+    if (!final_state) {
+      std::cerr << "can't write " << scenario.final_state_output << '\n';
+      return 1;
+    }
+    pr::write_boids(final_state, flock.boids());
+  }
+
+  // on the standard error, so that it doesn't mix with the statistics.
+  std::cerr << scenario.steps << " steps of " << flock.size() << " boids: "
+            << update_seconds * 1.e3 / static_cast<double>(scenario.steps)
+            << " ms per step\n";
+
+  return 0;
+}
@@ -0,0 +1,216 @@
+// benchmark of the hot paths of the simulation: every scenario is generated
+// from a fixed seed, so that the numbers of two releases can be compared.
+//
+// usage: flock_bench [--steps N] [--threads N] [--max-boids N] [--skin S]
+//                    [--reorder K]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "flock.hpp"
+
+namespace {
+// in_place: the uniform flock, updated in place (on a single thread) rather
+// than double buffered.
+enum class Scenario { uniform, cluster, predators, in_place };
+
+struct Bench_result {
+  double index;
+  double search;  // a second pass, which only finds the neighbours.
+  double rules;  // the neighbours found again, and the rules applied.
+  double limits;
+  double statistics;  // sampled.
+  double exact_statistics;  // negative when the flock is too big for them.
+};
+
+const char* name_of(Scenario scenario) {
+  switch (scenario) {
+    case Scenario::uniform:
+      return "uniform";
+    case Scenario::cluster:
+      return "cluster";
+    case Scenario::in_place:
+      return "in_place";
+    default:
+      return "predators";
+  }
+}
+
+// the side of the world grows with the flock, so that the density of the
+// uniform scenarios (about 35 neighbours per boid) doesn't depend on N.
+float world_side(std::size_t number_of_boids) {
+  return 30.f * std::sqrt(static_cast<float>(number_of_boids));
+}
+
+void populate(pr::Flock& flock, Scenario scenario,
+              std::size_t number_of_boids) {
+  std::mt19937 engine{20240611u + static_cast<unsigned int>(scenario)};
+  const float side = world_side(number_of_boids);
+  const pr::Spawn_area area =
+      scenario == Scenario::cluster
+          ? pr::Spawn_area::gaussian(pr::Vector2{0.5f * side, 0.5f * side},
+                                     0.1f * side)
+          : pr::Spawn_area::box(pr::Vector2{0.f, 0.f}, pr::Vector2{side, side});
+
+  // one predator every 20 boids.
+  const std::size_t predators =
+      scenario == Scenario::predators ? number_of_boids / 20 : 0;
+
+  flock.spawn(pr::Spawn_spec{area, number_of_boids - predators,
+                             pr::Species::prey, 1.f, 0.5f, 120.f, 180.f},
+              engine);
+  flock.spawn(pr::Spawn_spec{area, predators, pr::Species::predator, 1.f,
+                             0.5f, 120.f, 180.f},
+              engine);
+}
+
+Bench_result run(Scenario scenario, std::size_t number_of_boids, int steps,
+                 unsigned int threads, float skin, std::size_t reorder) {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.set_update_mode(scenario == Scenario::in_place
+                            ? pr::Update_mode::in_place
+                            : pr::Update_mode::double_buffered);
+  flock.set_thread_count(threads);
+  flock.set_neighbour_skin(skin);
+  flock.set_reordering(reorder);
+  populate(flock, scenario, number_of_boids);
+
+  const unsigned int side =
+      static_cast<unsigned int>(world_side(number_of_boids));
+  const float time_per_frame = 1.f / 60.f;
+
+  flock.update(time_per_frame, side, side);  // warm up.
+
+  Bench_result result{0., 0., 0., 0., 0., -1.};
+  float checksum{0.f};
+
+  for (int step{0}; step < steps; ++step) {
+    flock.update(time_per_frame, side, side);
+
+    const pr::Update_timings& timings = flock.last_update_timings();
+    result.index += timings.index;
+    result.rules += timings.rules;
+    result.limits += timings.limits;
+
+    // neighbour search alone: the same queries of the rules, only counted.
+    // The rules find their neighbours inside the update, so the search is
+    // part of the rules column too: the two columns overlap.
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i{0}; i < flock.size(); ++i) {
+      checksum += flock.close_boids_360(flock.single_boid(i));
+    }
+    result.search +=
+        pr::seconds_between(start, std::chrono::steady_clock::now());
+  }
+
+  // the statistics are computed once, and reported per boid like the other
+  // phases; the exact ones visit every pair of boids.
+  flock.set_statistics_mode(pr::Statistics_mode::sampled);
+  auto start = std::chrono::steady_clock::now();
+  checksum += flock.state().medium_distance;
+  result.statistics =
+      pr::seconds_between(start, std::chrono::steady_clock::now()) * steps;
+
+  if (number_of_boids <= 20000) {
+    flock.set_statistics_mode(pr::Statistics_mode::exact);
+    start = std::chrono::steady_clock::now();
+    checksum += flock.state().medium_distance;
+    result.exact_statistics =
+        pr::seconds_between(start, std::chrono::steady_clock::now()) * steps;
+  }
+
+  // printed to stderr, so that the compiler can't drop the queries.
+  std::cerr << name_of(scenario) << ' ' << number_of_boids
+            << " checksum: " << checksum << '\n';
+
+  return result;
+}
+
+void print_column(double seconds, std::size_t number_of_boids, int steps) {
+  if (seconds < 0.) {
+    std::cout << std::setw(12) << "-";
+
+  } else {
+    const double per_boid =
+        seconds * 1.e9 / (static_cast<double>(number_of_boids) * steps);
+    std::cout << std::setw(12) << std::fixed << std::setprecision(1)
+              << per_boid;
+  }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int steps{10};
+  unsigned int threads{1};
+  std::size_t max_boids{100000};
+  float skin{0.f};
+  std::size_t reorder{0};
+
+  for (int i{1}; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--steps") == 0) {
+      steps = std::max(1, std::atoi(argv[i + 1]));
+    } else if (std::strcmp(argv[i], "--threads") == 0) {
+      threads = static_cast<unsigned int>(std::max(1, std::atoi(argv[i + 1])));
+    } else if (std::strcmp(argv[i], "--max-boids") == 0) {
+      max_boids = static_cast<std::size_t>(std::atol(argv[i + 1]));
+    } else if (std::strcmp(argv[i], "--skin") == 0) {
+      skin = std::max(0.f, static_cast<float>(std::atof(argv[i + 1])));
+    } else if (std::strcmp(argv[i], "--reorder") == 0) {
+      reorder = static_cast<std::size_t>(std::max(0, std::atoi(argv[i + 1])));
+    } else {
+      std::cerr << "unknown option " << argv[i] << '\n';
+      return 1;
+    }
+  }
+
+  std::cout << "ns per boid per step, " << steps << " steps, " << threads
+            << " thread(s), neighbour skin " << skin << ", reordering every "
+            << reorder << " step(s)\n"
+            << std::left << std::setw(12) << "scenario" << std::right
+            << std::setw(10) << "boids" << std::setw(12) << "index"
+            << std::setw(12) << "search" << std::setw(14) << "search+rules"
+            << std::setw(12) << "limits" << std::setw(12) << "statistics"
+            << std::setw(12) << "exact stats" << '\n';
+
+  for (const Scenario scenario :
+       {Scenario::uniform, Scenario::cluster, Scenario::predators,
+        Scenario::in_place}) {
+    for (const std::size_t number_of_boids : {1000, 10000, 100000}) {
+      if (number_of_boids > max_boids) {
+        continue;
+      }
+
+      const Bench_result result =
+          run(scenario, number_of_boids, steps, threads, skin, reorder);
+
+      std::cout << std::left << std::setw(12) << name_of(scenario)
+                << std::right << std::setw(10) << number_of_boids;
+      print_column(result.index, number_of_boids, steps);
+      print_column(result.search, number_of_boids, steps);
+      std::cout << "  ";
+      print_column(result.rules, number_of_boids, steps);
+      print_column(result.limits, number_of_boids, steps);
+      print_column(result.statistics, number_of_boids, steps);
+      print_column(result.exact_statistics, number_of_boids, steps);
+      std::cout << std::endl;
+    }
+  }
+
+  // the population of the biggest scenario of the README, in one call.
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  const auto start = std::chrono::steady_clock::now();
+  populate(flock, Scenario::uniform, 1000000);
+  std::cout << "spawning 1000000 boids: " << std::fixed << std::setprecision(1)
+            << pr::seconds_between(start, std::chrono::steady_clock::now()) *
+                   1.e3
+            << " ms\n";
+
+  return 0;
+}
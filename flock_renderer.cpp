@@ -0,0 +1,129 @@
+#include "flock_renderer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace pr {
+Flock_renderer::Flock_renderer() : vertices_{sf::Triangles} {}
+
+void Flock_renderer::set_shape(Species species, const sf::CircleShape& shape) {
+  assert(shape.getPointCount() == 3);
+
+  const std::size_t index = static_cast<std::size_t>(species);
+  if (triangles_.size() <= index) {
+    triangles_.resize(index + 1);
+  }
+
+  // the transform of the shape without its position and rotation brings its
+  // points around the origin, as they are drawn for a boid in (0, 0).
+  sf::CircleShape prototype{shape};
+  prototype.setPosition(0.f, 0.f);
+  prototype.setRotation(0.f);
+
+  Boid_triangle& triangle = triangles_[index];
+  triangle.radius = 0.f;
+  for (std::size_t k{0}; k < 3; ++k) {
+    const sf::Vector2f point =
+        prototype.getTransform().transformPoint(prototype.getPoint(k));
+
+    triangle.points[k] = point;
+    triangle.radius = std::max(triangle.radius,
+                               std::sqrt(point.x * point.x + point.y * point.y));
+  }
+  triangle.color = shape.getFillColor();
+}
+
+void Flock_renderer::update(const Boid_store& boids,
+                            const sf::FloatRect& visible_area) {
+  update(boids, boids, visible_area);
+}
+
+void Flock_renderer::update(const Boid_store& previous_boids,
+                            const Boid_store& boids,
+                            const sf::FloatRect& visible_area) {
+  const float jump_distance = 100.f;
+
+  // resize() keeps the memory of the previous snapshots.
+  vertices_.resize(3 * boids.size());
+  from_.resize(3 * boids.size());
+  to_.resize(3 * boids.size());
+
+  std::size_t drawn{0};
+
+  for (std::size_t i{0}; i < boids.size(); ++i) {
+    const Boid_view boid = boids[i];
+    const std::size_t species = static_cast<std::size_t>(boid.species());
+    assert(species < triangles_.size());
+
+    const Boid_triangle& triangle = triangles_[species];
+    const Vector2 position = boid.position();
+    Vector2 previous_position = position;
+
+    // after a reordering of the flock the same index can hold another boid.
+    if (i < previous_boids.size() && previous_boids.id(i) == boid.id()) {
+      const Vector2 step = position - previous_boids.position(i);
+
+      // a boid which went through the border isn't dragged across the window.
+      if (step.dot_product(step) < jump_distance * jump_distance) {
+        previous_position = previous_boids.position(i);
+      }
+    }
+
+    const auto visible = [&visible_area, &triangle](const Vector2& point) {
+      return point.x_axis() + triangle.radius >= visible_area.left &&
+             point.x_axis() - triangle.radius <=
+                 visible_area.left + visible_area.width &&
+             point.y_axis() + triangle.radius >= visible_area.top &&
+             point.y_axis() - triangle.radius <=
+                 visible_area.top + visible_area.height;
+    };
+
+    if (!visible(position) && !visible(previous_position)) {
+      continue;
+    }
+
+    // the rotation of rotation_angle(), straight from the direction of the
+    // velocity: a boid which doesn't move isn't rotated.
+    const Vector2 velocity = boid.velocity();
+    const float speed = velocity.lenght_of_vector();
+    const float cos_angle = speed > 0.f ? -velocity.y_axis() / speed : 1.f;
+    const float sin_angle = speed > 0.f ? velocity.x_axis() / speed : 0.f;
+
+    for (std::size_t k{0}; k < 3; ++k) {
+      const sf::Vector2f& point = triangle.points[k];
+
+      // the same rotation of sf::Transformable::setRotation().
+      const float offset_x = cos_angle * point.x - sin_angle * point.y;
+      const float offset_y = sin_angle * point.x + cos_angle * point.y;
+
+      from_[drawn] = sf::Vector2f{previous_position.x_axis() + offset_x,
+                                  previous_position.y_axis() + offset_y};
+      to_[drawn] = sf::Vector2f{position.x_axis() + offset_x,
+                                position.y_axis() + offset_y};
+      vertices_[drawn].position = to_[drawn];
+      vertices_[drawn].color = triangle.color;
+      ++drawn;
+    }
+  }
+
+  vertices_.resize(drawn);
+  from_.resize(drawn);
+  to_.resize(drawn);
+}
+
+void Flock_renderer::interpolate(float alpha) {
+  assert(alpha >= 0.f && alpha <= 1.f);
+
+  for (std::size_t k{0}; k < from_.size(); ++k) {
+    vertices_[k].position =
+        sf::Vector2f{from_[k].x + (to_[k].x - from_[k].x) * alpha,
+                     from_[k].y + (to_[k].y - from_[k].y) * alpha};
+  }
+}
+
+void Flock_renderer::draw(sf::RenderTarget& target,
+                          sf::RenderStates states) const {
+  target.draw(vertices_, states);
+}
+}  // namespace pr
@@ -0,0 +1,59 @@
+#ifndef FLOCK_RENDERER_HPP
+#define FLOCK_RENDERER_HPP
+
+#include <array>
+#include <vector>
+
+#include "SFML/Graphics.hpp"
+#include "boid_store.hpp"
+
+namespace pr {
+// draws the whole flock with a single draw call: every boid is a triangle of
+// the same vertex array. update() builds the triangles once for every new
+// state of the flock, at both ends of the tick, and interpolate() only moves
+// them in between, frame by frame.
+class Flock_renderer : public sf::Drawable {
+  struct Boid_triangle {
+    std::array<sf::Vector2f, 3> points;  // relative to the position of the
+                                         // boid, before the rotation.
+    float radius;  // of the smallest circle around the boid holding them.
+
+    sf::Color color;
+  };
+
+  std::vector<Boid_triangle> triangles_;  // indexed by species.
+
+  sf::VertexArray vertices_;
+
+  std::vector<sf::Vector2f> from_;  // the vertices at the previous tick.
+
+  std::vector<sf::Vector2f> to_;  // the vertices at the current tick.
+
+  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+ public:
+  Flock_renderer();
+
+  // every boid of "species" is drawn like "shape", which has to be a
+  // triangle: its origin, scale and fill colour are kept, while its position
+  // and rotation are the ones of the boid.
+  void set_shape(Species species, const sf::CircleShape& shape);
+
+  void update(const Boid_store& boids, const sf::FloatRect& visible_area);
+
+  // the triangles of the boids which are in "visible_area" at the previous
+  // tick or at the current one, going from their previous positions to the
+  // current ones (the boids which aren't at the same index of
+  // "previous_boids" stay where they are). They are drawn at the current
+  // positions until interpolate() is called.
+  void update(const Boid_store& previous_boids, const Boid_store& boids,
+              const sf::FloatRect& visible_area);
+
+  // draws the boids "alpha" of the way from their previous positions to the
+  // current ones, so that the motion is smooth between two ticks: no boid is
+  // read again.
+  void interpolate(float alpha);
+};
+}  // namespace pr
+
+#endif
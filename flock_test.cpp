@@ -1,8 +1,102 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "flock.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
 #include "doctest.h"
 
+// every allocation of the test program is counted, so that the tests can
+// check that a steady simulation doesn't allocate. The whole family of
+// operator new and delete goes through the two helpers below, which are
+// kept out of line: otherwise the compiler sees the malloc() of one
+// operator and the free() of another, and takes them for a mismatch.
+namespace {
+std::atomic<std::size_t> allocations{0};
+
+[[gnu::noinline]] void* counted_allocation(std::size_t size,
+                                           std::size_t alignment) {
+  ++allocations;
+
+  size = size == 0 ? 1 : size;
+  void* memory =
+      alignment <= alignof(std::max_align_t)
+          ? std::malloc(size)
+          : std::aligned_alloc(alignment,
+                               (size + alignment - 1) / alignment * alignment);
+  if (memory == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  return memory;
+}
+
+[[gnu::noinline]] void release(void* memory) noexcept { std::free(memory); }
+
+// "count" boids spread over a 800x600 world with the same few velocities,
+// one predator every 40 boids: the flock of the tests which compare two
+// ways of updating it.
+std::vector<pr::Boid> lattice_boids(int count, float maximum_velocity = 10.f) {
+  std::vector<pr::Boid> boids;
+  for (int i{0}; i < count; ++i) {
+    const pr::Vector2 position{static_cast<float>((i * 37) % 800),
+                               static_cast<float>((i * 91) % 600)};
+    const pr::Vector2 velocity{static_cast<float>(i % 7) - 3.5f,
+                               static_cast<float>(i % 5) - 2.5f};
+    const pr::Species species =
+        i % 40 == 0 ? pr::Species::predator : pr::Species::prey;
+
+    boids.push_back(pr::Boid{position, velocity, maximum_velocity, 150.f,
+                             species});
+  }
+
+  return boids;
+}
+}  // namespace
+
+void* operator new(std::size_t size) { return counted_allocation(size, 0); }
+
+void* operator new[](std::size_t size) { return counted_allocation(size, 0); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { release(memory); }
+
+void operator delete[](void* memory) noexcept { release(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { release(memory); }
+
+void operator delete[](void* memory, std::size_t) noexcept {
+  release(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+  release(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  release(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  release(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  release(memory);
+}
+
 TEST_CASE("Testing the quadratic_difference() method") {
   SUBCASE("Three values:") {
     const std::vector<float> generic_vector{7.810249676f, 9.219544457f,
@@ -34,10 +128,10 @@ TEST_CASE("Testing the close_boids() method") {
   pr::Boid b3{v3, v3, 500.f, 180.f};
   pr::Boid b4{v4, v4, 500.f, 180.f};
 
-  b1.set_shape().setFillColor(sf::Color::Red);
-  b2.set_shape().setFillColor(sf::Color::Red);
-  b3.set_shape().setFillColor(sf::Color::Red);
-  b4.set_shape().setFillColor(sf::Color::Red);
+  b1.set_species(pr::Species::prey);
+  b2.set_species(pr::Species::prey);
+  b3.set_species(pr::Species::prey);
+  b4.set_species(pr::Species::prey);
 
   flock.push_back(b1);
   flock.push_back(b2);
@@ -61,10 +155,10 @@ TEST_CASE("Testing the find_centermass() method") {
     pr::Boid b3{v3, v3, 200.f, 180.f};
     pr::Boid b4{v4, v4, 200.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
 
     flock.push_back(b1);
     flock.push_back(b2);
@@ -94,11 +188,11 @@ TEST_CASE("Testing the find_centermass() method") {
     pr::Boid b4{v4, v4, 100.f, 180.f};
     pr::Boid b5{v5, v5, 100.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
-    b5.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
+    b5.set_species(pr::Species::prey);
 
     flock.push_back(b1);
     flock.push_back(b2);
@@ -125,9 +219,9 @@ TEST_CASE("Testing the find_centermass() method") {
     pr::Boid b2{v2, v2, 100.f, 180.f};
     pr::Boid b3{v3, v3, 100.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
 
     flock.push_back(b1);
     flock.push_back(b2);
@@ -152,10 +246,10 @@ TEST_CASE("Testing the find_centermass() method") {
     pr::Boid b3{v3, v3, 100000.f, 180.f};
     pr::Boid b4{v4, v4, 100000.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
 
     flock.push_back(b1);
     flock.push_back(b2);
@@ -181,10 +275,10 @@ TEST_CASE("Testing the is_predator() method") {
   pr::Boid b3{v3, v5, 10000.f, 180.f};
   pr::Boid b4{v4, v5, 10000.f, 180.f};
 
-  b1.set_shape().setFillColor(sf::Color::Red);
-  b2.set_shape().setFillColor(sf::Color::Red);
-  b3.set_shape().setFillColor(sf::Color::Black);
-  b4.set_shape().setFillColor(sf::Color::Black);
+  b1.set_species(pr::Species::prey);
+  b2.set_species(pr::Species::prey);
+  b3.set_species(pr::Species::predator);
+  b4.set_species(pr::Species::predator);
 
   pr::Flock flock{100, 30, 0.05, 0.5, 0.0005};
 
@@ -199,6 +293,54 @@ TEST_CASE("Testing the is_predator() method") {
   CHECK(flock.is_predator(b4) == false);
 }
 
+TEST_CASE("Testing the in_limits() method") {
+  pr::Boid prey{pr::Vector2{610.f, 300.f}, pr::Vector2{4.f, -2.f}, 10000.f,
+                180.f};
+  pr::Boid chased{pr::Vector2{-10.f, 300.f}, pr::Vector2{-4.f, 2.f}, 10000.f,
+                  180.f};
+  pr::Boid predator{pr::Vector2{20.f, 300.f}, pr::Vector2{-4.f, 0.f}, 10000.f,
+                    180.f};
+  predator.set_species(pr::Species::predator);
+
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.push_back(prey);
+  flock.push_back(chased);
+  flock.push_back(predator);
+
+  SUBCASE("A boid out of the window bounces back:") {
+    flock.in_limits(prey, 600, 600);
+
+    CHECK(prey.position() == pr::Vector2{610.f, 300.f});
+    CHECK(prey.velocity() == pr::Vector2{-4.f, -2.f});
+
+    // once it points back inside, its velocity is kept.
+    flock.in_limits(prey, 600, 600);
+    CHECK(prey.velocity() == pr::Vector2{-4.f, -2.f});
+  }
+
+  SUBCASE("A chased boid goes through the border:") {
+    flock.in_limits(chased, 600, 600);
+
+    CHECK(chased.position() == pr::Vector2{590.f, 300.f});
+    CHECK(chased.velocity() == pr::Vector2{-4.f, 2.f});
+  }
+
+  SUBCASE("A boid in the window is left alone:") {
+    flock.in_limits(predator, 600, 600);
+
+    CHECK(predator.position() == pr::Vector2{20.f, 300.f});
+    CHECK(predator.velocity() == pr::Vector2{-4.f, 0.f});
+  }
+
+  SUBCASE("The other boids are never changed:") {
+    flock.in_limits(prey, 600, 600);
+    flock.in_limits(chased, 600, 600);
+
+    CHECK(flock.single_boid(0).velocity() == pr::Vector2{4.f, -2.f});
+    CHECK(flock.single_boid(1).position() == pr::Vector2{-10.f, 300.f});
+  }
+}
+
 TEST_CASE("Testing the evolve() method") {
   SUBCASE("Five boids, two are close to the chosen one:") {
     const pr::Vector2 v1{15.8f, 500.f};
@@ -218,11 +360,11 @@ TEST_CASE("Testing the evolve() method") {
     pr::Boid b4{v7, v8, 10000.f, 180.f};
     pr::Boid b5{v9, v10, 10000.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
-    b5.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
+    b5.set_species(pr::Species::prey);
 
     pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
 
@@ -316,13 +458,13 @@ TEST_CASE("Testing the evolve() method") {
     pr::Boid b6{v11, v12, 1000.f, 180.f};
     pr::Boid b7{v13, v14, 1000.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
-    b5.set_shape().setFillColor(sf::Color::Red);
-    b6.set_shape().setFillColor(sf::Color::Red);
-    b7.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
+    b5.set_species(pr::Species::prey);
+    b6.set_species(pr::Species::prey);
+    b7.set_species(pr::Species::prey);
 
     pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
 
@@ -428,10 +570,10 @@ TEST_CASE("Testing the evolve() method") {
     pr::Boid b3{v5, v6, 1000.f, 180.f};
     pr::Boid b4{v7, v8, 1000.f, 180.f};
 
-    b1.set_shape().setFillColor(sf::Color::Red);
-    b2.set_shape().setFillColor(sf::Color::Red);
-    b3.set_shape().setFillColor(sf::Color::Red);
-    b4.set_shape().setFillColor(sf::Color::Red);
+    b1.set_species(pr::Species::prey);
+    b2.set_species(pr::Species::prey);
+    b3.set_species(pr::Species::prey);
+    b4.set_species(pr::Species::prey);
 
     pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
 
@@ -560,3 +702,621 @@ TEST_CASE("Testing the state() function") {
     CHECK(state.err_distance == doctest::Approx(0.8641936).epsilon(0.0000001));
   }
 }
+
+TEST_CASE("Testing the sampled state() function") {
+  pr::Flock exact{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  pr::Flock sampled{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  sampled.set_statistics_mode(pr::Statistics_mode::sampled, 20000);
+
+  SUBCASE("Fewer pairs than samples are computed exactly:") {
+    for (const pr::Boid& boid : lattice_boids(100)) {
+      exact.push_back(boid);
+      sampled.push_back(boid);
+    }
+
+    const pr::Simulation_state exact_state = exact.state();
+    const pr::Simulation_state sampled_state = sampled.state();
+
+    CHECK(sampled.statistics_mode() == pr::Statistics_mode::sampled);
+    CHECK(sampled_state.medium_distance == exact_state.medium_distance);
+    CHECK(sampled_state.err_distance == exact_state.err_distance);
+  }
+
+  SUBCASE("More pairs than samples are estimated:") {
+    for (const pr::Boid& boid : lattice_boids(2000)) {
+      exact.push_back(boid);
+      sampled.push_back(boid);
+    }
+
+    const pr::Simulation_state exact_state = exact.state();
+    const pr::Simulation_state sampled_state = sampled.state();
+
+    // the velocities never are sampled.
+    CHECK(sampled_state.medium_velocity ==
+          doctest::Approx(exact_state.medium_velocity));
+    CHECK(sampled_state.err_velocity ==
+          doctest::Approx(exact_state.err_velocity));
+
+    // 20000 samples make the relative error of the mean about 0.5%.
+    CHECK(sampled_state.medium_distance ==
+          doctest::Approx(exact_state.medium_distance).epsilon(0.03));
+    CHECK(sampled_state.err_distance ==
+          doctest::Approx(exact_state.err_distance).epsilon(0.05));
+  }
+}
+
+TEST_CASE("Testing the statistics computed by update()") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  for (const pr::Boid& boid : lattice_boids(50)) {
+    flock.push_back(boid);
+  }
+
+  SUBCASE("Not computed by default:") {
+    flock.update(1.f / 60.f, 800, 600);
+
+    CHECK(flock.computed_states() == 0);
+  }
+
+  SUBCASE("Every two updates:") {
+    flock.set_statistics_cadence(2, 0.f);
+
+    flock.update(1.f / 60.f, 800, 600);
+    CHECK(flock.computed_states() == 0);
+
+    flock.update(1.f / 60.f, 800, 600);
+    CHECK(flock.computed_states() == 1);
+
+    const pr::Simulation_state latest = flock.latest_state();
+    const pr::Simulation_state state = flock.state();
+    CHECK(latest.medium_velocity == state.medium_velocity);
+    CHECK(latest.medium_distance == state.medium_distance);
+  }
+}
+
+TEST_CASE("Testing the find_neighbourhood() method") {
+  const pr::Vector2 v1{15.8f, 500.f};
+  const pr::Vector2 v2{100.f, 50.f};
+  const pr::Vector2 v3{20.f, 450.f};
+  const pr::Vector2 v4{200.f, 20.f};
+  const pr::Vector2 v5{1000.f, 2000.f};
+  const pr::Vector2 v6{10.f, 10.f};
+  const pr::Vector2 v7{16.5f, 510.f};
+  const pr::Vector2 v8{50.f, 80.f};
+  const pr::Vector2 v9{15.f, 420.f};
+
+  pr::Boid b1{v1, v2, 1000.f, 180.f};
+  pr::Boid b2{v3, v4, 10000.f, 180.f};
+  pr::Boid b3{v5, v6, 10000.f, 180.f};
+  pr::Boid b4{v7, v8, 10000.f, 180.f};
+  pr::Boid b5{v9, v6, 10000.f, 180.f};
+
+  b1.set_species(pr::Species::prey);
+  b2.set_species(pr::Species::prey);
+  b3.set_species(pr::Species::prey);
+  b4.set_species(pr::Species::prey);
+  b5.set_species(pr::Species::predator);
+
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  flock.push_back(b1);
+  flock.push_back(b2);
+  flock.push_back(b3);
+  flock.push_back(b4);
+  flock.push_back(b5);
+
+  const pr::Neighbourhood neighbourhood = flock.find_neighbourhood(b1);
+
+  CHECK(neighbourhood.close_boids == doctest::Approx(3.0).epsilon(0.1));
+  CHECK(neighbourhood.visible_boids == doctest::Approx(2.0).epsilon(0.1));
+
+  CHECK(neighbourhood.positions_sum.x_axis() ==
+        doctest::Approx(36.5).epsilon(0.01));
+  CHECK(neighbourhood.positions_sum.y_axis() ==
+        doctest::Approx(960.0).epsilon(0.1));
+
+  CHECK(neighbourhood.relative_velocities_sum.x_axis() ==
+        doctest::Approx(50.0).epsilon(0.1));
+  CHECK(neighbourhood.relative_velocities_sum.y_axis() ==
+        doctest::Approx(0.0).epsilon(0.1));
+
+  CHECK(neighbourhood.separation.x_axis() ==
+        doctest::Approx(0.7).epsilon(0.01));
+  CHECK(neighbourhood.separation.y_axis() ==
+        doctest::Approx(10.0).epsilon(0.1));
+
+  CHECK(flock.find_cohesion(b1).x_axis() ==
+        flock.velocity_offset(b1, neighbourhood).x_axis());
+  CHECK(flock.find_cohesion(b1).y_axis() ==
+        flock.velocity_offset(b1, neighbourhood).y_axis());
+}
+
+TEST_CASE("Testing a flock of three species") {
+  const pr::Species gull = static_cast<pr::Species>(2);
+
+  // gulls flock among themselves and keep away from everything, while the
+  // prey and the predators ignore them.
+  pr::Interaction_table table = pr::Interaction_table::prey_and_predators();
+  pr::Interaction_table three_species{3};
+  for (const pr::Species chosen : {pr::Species::prey, pr::Species::predator}) {
+    for (const pr::Species other : {pr::Species::prey, pr::Species::predator}) {
+      three_species.set(chosen, other, table(chosen, other));
+    }
+  }
+  three_species.set(gull, gull, {true, true, true, false});
+  three_species.set(gull, pr::Species::prey, {false, false, true, false});
+  three_species.set(gull, pr::Species::predator, {false, false, true, true});
+
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.set_interactions(three_species);
+  CHECK(flock.interactions().species_count() == 3);
+
+  const pr::Boid b1{pr::Vector2{100.f, 100.f}, pr::Vector2{1.f, 1.f}, 10.f,
+                    180.f, gull};
+  flock.push_back(b1);
+  flock.push_back(pr::Boid{pr::Vector2{110.f, 110.f}, pr::Vector2{2.f, 1.f},
+                           10.f, 180.f, gull});
+  flock.push_back(pr::Boid{pr::Vector2{90.f, 110.f}, pr::Vector2{1.f, 3.f},
+                           10.f, 180.f, pr::Species::prey});
+  flock.push_back(pr::Boid{pr::Vector2{150.f, 100.f}, pr::Vector2{1.f, 2.f},
+                           10.f, 180.f, pr::Species::predator});
+
+  const pr::Neighbourhood gull_neighbourhood = flock.find_neighbourhood(b1);
+
+  CHECK(gull_neighbourhood.close_boids == doctest::Approx(3.0).epsilon(0.1));
+  CHECK(gull_neighbourhood.visible_boids == doctest::Approx(1.0).epsilon(0.1));
+  CHECK(gull_neighbourhood.aligned_boids == doctest::Approx(1.0).epsilon(0.1));
+  CHECK(gull_neighbourhood.relative_velocities_sum == pr::Vector2{1.f, 0.f});
+  // the gull and the prey are closer than 30.
+  CHECK(gull_neighbourhood.separation == pr::Vector2{0.f, 20.f});
+  CHECK(flock.is_predator(b1) == true);
+
+  // the prey don't see the gulls.
+  const pr::Neighbourhood prey_neighbourhood =
+      flock.find_neighbourhood(flock.single_boid(2));
+  CHECK(prey_neighbourhood.visible_boids == doctest::Approx(0.0).epsilon(0.1));
+  CHECK(prey_neighbourhood.separation == pr::Vector2{0.f, 0.f});
+}
+
+TEST_CASE("Testing the double_buffered update() mode") {
+  const pr::Vector2 v1{515.8f, 500.f};
+  const pr::Vector2 v2{100.f, 50.f};
+  const pr::Vector2 v3{520.f, 450.f};
+  const pr::Vector2 v4{200.f, 20.f};
+  const pr::Vector2 v5{516.5f, 510.f};
+  const pr::Vector2 v6{50.f, 80.f};
+  const pr::Vector2 v7{600.f, 520.f};
+  const pr::Vector2 v8{-30.f, 10.f};
+
+  const std::vector<pr::Boid> boids{pr::Boid{v1, v2, 1000.f, 180.f},
+                                    pr::Boid{v3, v4, 10000.f, 180.f},
+                                    pr::Boid{v5, v6, 10000.f, 150.f},
+                                    pr::Boid{v7, v8, 10000.f, 120.f}};
+
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.set_update_mode(pr::Update_mode::double_buffered);
+
+  for (const pr::Boid& boid : boids) {
+    flock.push_back(boid);
+  }
+
+  CHECK(flock.update_mode() == pr::Update_mode::double_buffered);
+
+  SUBCASE("Every boid evolves against the flock at the beginning of the step:") {
+    std::vector<pr::Boid> expected = boids;
+    for (pr::Boid& boid : expected) {
+      flock.evolve(boid, 0.5f);
+    }
+
+    flock.update(0.5f / 210.f, 10000, 10000);
+
+    for (std::size_t i{0}; i < boids.size(); ++i) {
+      CHECK(flock.single_boid(i).position().x_axis() ==
+            doctest::Approx(expected[i].position().x_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).position().y_axis() ==
+            doctest::Approx(expected[i].position().y_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).velocity().x_axis() ==
+            doctest::Approx(expected[i].velocity().x_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).velocity().y_axis() ==
+            doctest::Approx(expected[i].velocity().y_axis()).epsilon(0.0001));
+    }
+  }
+
+  SUBCASE("The order of the boids doesn't change the result:") {
+    pr::Flock reversed{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+    reversed.set_update_mode(pr::Update_mode::double_buffered);
+
+    for (auto it = boids.rbegin(); it != boids.rend(); ++it) {
+      reversed.push_back(*it);
+    }
+
+    for (int step{0}; step < 20; ++step) {
+      flock.update(0.5f / 210.f, 600, 600);
+      reversed.update(0.5f / 210.f, 600, 600);
+    }
+
+    for (std::size_t i{0}; i < boids.size(); ++i) {
+      const pr::Boid same = reversed.single_boid(boids.size() - 1 - i);
+
+      CHECK(flock.single_boid(i).position().x_axis() ==
+            doctest::Approx(same.position().x_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).position().y_axis() ==
+            doctest::Approx(same.position().y_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).velocity().x_axis() ==
+            doctest::Approx(same.velocity().x_axis()).epsilon(0.0001));
+      CHECK(flock.single_boid(i).velocity().y_axis() ==
+            doctest::Approx(same.velocity().y_axis()).epsilon(0.0001));
+    }
+  }
+}
+
+TEST_CASE("Testing the multithreaded update()") {
+  pr::Flock single{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  pr::Flock threaded{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  single.set_update_mode(pr::Update_mode::double_buffered);
+  threaded.set_update_mode(pr::Update_mode::double_buffered);
+  threaded.set_thread_count(4);
+
+  for (const pr::Boid& boid : lattice_boids(2000)) {
+    single.push_back(boid);
+    threaded.push_back(boid);
+  }
+
+  for (int step{0}; step < 10; ++step) {
+    single.update(1.f / 60.f, 800, 600);
+    threaded.update(1.f / 60.f, 800, 600);
+  }
+
+  CHECK(single.thread_count() == 1);
+  CHECK(threaded.thread_count() == 4);
+
+  bool same{true};
+  for (std::size_t i{0}; i < single.size(); ++i) {
+    same = same && single.single_boid(i) == threaded.single_boid(i);
+  }
+  CHECK(same == true);
+}
+
+TEST_CASE("Testing the update() with neighbour lists") {
+  for (const pr::Update_mode mode :
+       {pr::Update_mode::in_place, pr::Update_mode::double_buffered}) {
+    pr::Flock searched{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+    pr::Flock listed{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+    searched.set_update_mode(mode);
+    listed.set_update_mode(mode);
+    listed.set_neighbour_skin(30.f);
+
+    for (const pr::Boid& boid : lattice_boids(500, 1.f)) {
+      searched.push_back(boid);
+      listed.push_back(boid);
+    }
+
+    CHECK(searched.neighbour_skin() == 0.f);
+    CHECK(listed.neighbour_skin() == 30.f);
+
+    for (int step{0}; step < 12; ++step) {
+      searched.update(1.f / 60.f, 800, 600);
+      listed.update(1.f / 60.f, 800, 600);
+    }
+
+    // the boids move less than half the skin per update: every list lasts
+    // at least two of them.
+    CHECK(searched.neighbour_list_rebuilds() == 0);
+    CHECK(listed.neighbour_list_rebuilds() >= 2);
+    CHECK(listed.neighbour_list_rebuilds() <= 8);
+
+    for (std::size_t i{0}; i < searched.size(); ++i) {
+      const pr::Boid expected = searched.single_boid(i);
+      const pr::Boid boid = listed.single_boid(i);
+
+      CHECK(boid.position().x_axis() ==
+            doctest::Approx(expected.position().x_axis()).epsilon(0.001));
+      CHECK(boid.position().y_axis() ==
+            doctest::Approx(expected.position().y_axis()).epsilon(0.001));
+    }
+  }
+}
+
+TEST_CASE("Testing the in-place update() when most boids leave their lists") {
+  pr::Flock searched{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  pr::Flock listed{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  searched.set_update_mode(pr::Update_mode::in_place);
+  listed.set_update_mode(pr::Update_mode::in_place);
+
+  // the boids move about a hundredth of a pixel per update, more than half
+  // the skin: nearly all of them leave their lists during each sweep.
+  listed.set_neighbour_skin(0.02f);
+
+  for (const pr::Boid& boid : lattice_boids(500, 1.f)) {
+    searched.push_back(boid);
+    listed.push_back(boid);
+  }
+
+  for (int step{0}; step < 6; ++step) {
+    searched.update(1.f / 60.f, 800, 600);
+    listed.update(1.f / 60.f, 800, 600);
+  }
+
+  // the sweeps went on with the grid, and every update rebuilt the lists.
+  CHECK(listed.neighbour_list_rebuilds() == 6);
+
+  for (std::size_t i{0}; i < searched.size(); ++i) {
+    const pr::Boid expected = searched.single_boid(i);
+    const pr::Boid boid = listed.single_boid(i);
+
+    CHECK(boid.position().x_axis() ==
+          doctest::Approx(expected.position().x_axis()).epsilon(0.001));
+    CHECK(boid.position().y_axis() ==
+          doctest::Approx(expected.position().y_axis()).epsilon(0.001));
+  }
+}
+
+TEST_CASE("Testing the reordering of the storage") {
+  pr::Flock plain{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  pr::Flock reordered{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  plain.set_update_mode(pr::Update_mode::double_buffered);
+  reordered.set_update_mode(pr::Update_mode::double_buffered);
+  reordered.set_reordering(3);
+  reordered.set_neighbour_skin(30.f);
+
+  for (const pr::Boid& boid : lattice_boids(500, 1.f)) {
+    plain.push_back(boid);
+    reordered.push_back(boid);
+  }
+
+  CHECK(plain.reordering() == 0);
+  CHECK(reordered.reordering() == 3);
+
+  for (int step{0}; step < 10; ++step) {
+    plain.update(1.f / 60.f, 800, 600);
+    reordered.update(1.f / 60.f, 800, 600);
+  }
+
+  SUBCASE("The storage is sorted, the ids are kept:") {
+    bool moved{false};
+    std::vector<std::size_t> ids;
+
+    for (const pr::Boid_view boid : reordered.boids()) {
+      moved = moved || boid.id() != boid.index();
+      ids.push_back(boid.id());
+
+      CHECK(reordered.boid_view(boid.id()).index() == boid.index());
+    }
+    std::sort(ids.begin(), ids.end());
+
+    CHECK(moved == true);
+    for (std::size_t i{0}; i < ids.size(); ++i) {
+      CHECK(ids[i] == i);
+    }
+  }
+
+  SUBCASE("The boids move like in the flock which is never reordered:") {
+    const std::vector<pr::Boid> expected = plain.all_boids();
+    const std::vector<pr::Boid> boids = reordered.all_boids();
+
+    for (std::size_t i{0}; i < plain.size(); ++i) {
+      CHECK(reordered.single_boid(i) == boids[i]);
+      CHECK(boids[i].position().x_axis() ==
+            doctest::Approx(expected[i].position().x_axis()).epsilon(0.001));
+      CHECK(boids[i].position().y_axis() ==
+            doctest::Approx(expected[i].position().y_axis()).epsilon(0.001));
+    }
+  }
+}
+
+TEST_CASE("Testing the handles and the removal of boids") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+
+  std::vector<pr::Boid_handle> handles;
+  for (int i{0}; i < 5; ++i) {
+    const float coordinate = 10.f * static_cast<float>(i);
+    handles.push_back(flock.push_back(
+        pr::Boid{pr::Vector2{coordinate, coordinate}, pr::Vector2{1.f, 0.f},
+                 10.f, 150.f}));
+  }
+  const pr::Boid last = flock.single_boid(handles[4]);
+
+  CHECK(flock.remove(handles[1]) == true);
+
+  SUBCASE("The removed boid is gone, the others are still found:") {
+    CHECK(flock.size() == 4);
+    CHECK(flock.contains(handles[1]) == false);
+    CHECK(flock.remove(handles[1]) == false);
+
+    for (const std::size_t i : {0, 2, 3, 4}) {
+      CHECK(flock.contains(handles[i]) == true);
+      CHECK(flock.boid_view(handles[i]).id() == handles[i].id);
+      CHECK(flock.handle_at(flock.boid_view(handles[i]).index()) ==
+            handles[i]);
+    }
+
+    // swap and pop: the last boid took the place of the removed one.
+    CHECK(flock.boids().boid(1) == last);
+    CHECK(flock.all_boids().size() == 4);
+  }
+
+  SUBCASE("The id of a removed boid goes to a new one:") {
+    const pr::Boid_handle handle = flock.push_back(
+        pr::Boid{pr::Vector2{500.f, 500.f}, pr::Vector2{}, 10.f, 150.f});
+
+    CHECK(handle.id == handles[1].id);
+    CHECK(handle != handles[1]);
+    CHECK(flock.contains(handle) == true);
+    CHECK(flock.contains(handles[1]) == false);
+    CHECK(flock.single_boid(handle).position() == pr::Vector2{500.f, 500.f});
+  }
+
+  SUBCASE("The queries don't see the removed boid:") {
+    const pr::Boid chosen = flock.single_boid(handles[0]);
+
+    CHECK(flock.close_boids_360(chosen) == 3.f);
+    CHECK(flock.find_neighbourhood(chosen).close_boids == 3.f);
+  }
+
+  SUBCASE("The flock keeps updating with churn:") {
+    flock.set_neighbour_skin(20.f);
+    flock.set_reordering(2);
+
+    for (int step{0}; step < 20; ++step) {
+      flock.update(1.f / 60.f, 800, 600);
+
+      CHECK(flock.remove(flock.handle_at(0)) == true);
+      flock.push_back(pr::Boid{pr::Vector2{400.f, 300.f},
+                               pr::Vector2{1.f, 1.f}, 10.f, 150.f});
+    }
+
+    CHECK(flock.size() == 4);
+  }
+}
+
+TEST_CASE("Testing the spawn() method") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  std::mt19937 engine{7};
+
+  const pr::Boid_handle first = flock.push_back(
+      pr::Boid{pr::Vector2{5.f, 5.f}, pr::Vector2{}, 10.f, 150.f});
+  flock.spawn(pr::Spawn_spec{pr::Spawn_area::box(pr::Vector2{0.f, 0.f},
+                                                 pr::Vector2{800.f, 600.f}),
+                             1000, pr::Species::prey, 1.f, 10.f, 120.f, 180.f},
+              engine);
+  flock.spawn(pr::Spawn_spec{pr::Spawn_area::ring(pr::Vector2{400.f, 300.f},
+                                                  50.f, 60.f),
+                             10, pr::Species::predator, 1.f, 20.f, 90.f, 90.f},
+              engine);
+
+  CHECK(flock.size() == 1011);
+  CHECK(flock.contains(first) == true);
+
+  bool in_box{true};
+  for (std::size_t i{1}; i < 1001; ++i) {
+    const pr::Boid_view boid = flock.boids()[i];
+
+    in_box = in_box && boid.species() == pr::Species::prey &&
+             boid.position().x_axis() >= 0.f &&
+             boid.position().x_axis() <= 800.f &&
+             boid.view_angle() >= 120.f && boid.view_angle() <= 180.f;
+  }
+  CHECK(in_box == true);
+
+  // the new boids are at the end of the storage, and found by the grid.
+  for (std::size_t i{1001}; i < 1011; ++i) {
+    const pr::Boid boid = flock.single_boid(flock.handle_at(i));
+
+    CHECK(boid.species() == pr::Species::predator);
+    CHECK(boid.maximum_velocity() == 20.f);
+    CHECK(boid.position().distance(pr::Vector2{400.f, 300.f}) ==
+          doctest::Approx(55.f).epsilon(0.1));
+  }
+  CHECK(flock.close_boids_360(pr::Boid{pr::Vector2{400.f, 300.f},
+                                       pr::Vector2{}, 10.f, 150.f}) >= 10.f);
+
+  SUBCASE("The same seed spawns the same flock:") {
+    pr::Flock copy{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+    std::mt19937 same_engine{7};
+
+    copy.push_back(pr::Boid{pr::Vector2{5.f, 5.f}, pr::Vector2{}, 10.f, 150.f});
+    copy.spawn(pr::Spawn_spec{pr::Spawn_area::box(pr::Vector2{0.f, 0.f},
+                                                  pr::Vector2{800.f, 600.f}),
+                              1000, pr::Species::prey, 1.f, 10.f, 120.f,
+                              180.f},
+               same_engine);
+
+    CHECK(copy.single_boid(500) == flock.single_boid(500));
+  }
+}
+
+TEST_CASE("Testing the boids() view of the flock") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.push_back(pr::Boid{pr::Vector2{10.f, 20.f}, pr::Vector2{1.f, 2.f},
+                           10.f, 150.f, pr::Species::prey});
+  flock.push_back(pr::Boid{pr::Vector2{30.f, 40.f}, pr::Vector2{-1.f, 3.f},
+                           10.f, 150.f, pr::Species::predator});
+
+  const pr::Boid_store& boids = flock.boids();
+  const std::size_t allocations_before = allocations.load();
+  std::size_t visited{0};
+
+  for (const pr::Boid_view boid : boids) {
+    CHECK(boid.boid() == flock.single_boid(visited));
+    CHECK(flock.boid_view(visited).position() == boid.position());
+    ++visited;
+  }
+
+  CHECK(allocations.load() == allocations_before);
+  CHECK(visited == flock.size());
+
+  flock.update(1.f / 60.f, 800, 600);
+  CHECK(boids[1].boid() == flock.single_boid(1));
+}
+
+TEST_CASE("Testing that a steady update() doesn't allocate") {
+  const auto allocations_of_steps = [](pr::Update_mode mode,
+                                       unsigned int threads,
+                                       std::size_t reordering = 0) {
+    pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+    flock.set_update_mode(mode);
+    flock.set_thread_count(threads);
+    flock.set_reordering(reordering);
+
+    for (const pr::Boid& boid : lattice_boids(300)) {
+      flock.push_back(boid);
+    }
+
+    // the first steps (up to the first reordering) size the buffers.
+    for (std::size_t step{0}; step < std::max<std::size_t>(reordering, 1);
+         ++step) {
+      flock.update(1.f / 60.f, 800, 600);
+    }
+    flock.state();
+
+    const std::size_t before = allocations.load();
+    for (int step{0}; step < 100; ++step) {
+      flock.update(1.f / 60.f, 800, 600);
+      flock.state();
+    }
+
+    return allocations.load() - before;
+  };
+
+  SUBCASE("In place:") {
+    CHECK(allocations_of_steps(pr::Update_mode::in_place, 1) == 0);
+  }
+
+  SUBCASE("Double buffered, single thread:") {
+    CHECK(allocations_of_steps(pr::Update_mode::double_buffered, 1) == 0);
+  }
+
+  SUBCASE("Double buffered, three threads:") {
+    CHECK(allocations_of_steps(pr::Update_mode::double_buffered, 3) == 0);
+  }
+
+  SUBCASE("Double buffered, storage reordered every other step:") {
+    CHECK(allocations_of_steps(pr::Update_mode::double_buffered, 1, 2) == 0);
+  }
+}
+
+TEST_CASE("Testing the grid after a boid went through the border") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.set_update_mode(pr::Update_mode::double_buffered);
+
+  // the prey is chased, so it goes through the right border instead of
+  // bouncing on it.
+  flock.push_back(pr::Boid{pr::Vector2{795.f, 300.f}, pr::Vector2{10.f, 0.f},
+                           10.f, 150.f, pr::Species::prey});
+  flock.push_back(pr::Boid{pr::Vector2{600.f, 300.f}, pr::Vector2{0.f, 1.f},
+                           10.f, 150.f, pr::Species::predator});
+
+  flock.update(1.f / 60.f, 800, 600);
+
+  const pr::Vector2 position = flock.single_boid(0).position();
+  CHECK(position.x_axis() < 100.f);
+
+  // a query made before the next update finds it where it is now.
+  CHECK(flock.close_boids_360(pr::Boid{position + pr::Vector2{1.f, 0.f},
+                                       pr::Vector2{0.f, 1.f}, 10.f, 150.f,
+                                       pr::Species::prey}) == 1.f);
+}
@@ -1,52 +1,61 @@
+#include <chrono>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <string>
+#include <utility>
 
 #include "SFML/Graphics.hpp"
 #include "flock.hpp"
+#include "flock_renderer.hpp"
+#include "scenario.hpp"
+#include "simulation_thread.hpp"
+
+int main(int argc, char* argv[]) {
+  // the parameters of the flock and its first boids come from a scenario
+  // file and/or the command line (see the README): by default the flock is
+  // empty, and it is filled with the mouse.
+  pr::Scenario scenario;
+  std::string error;
+
+  if (!pr::parse_arguments(argc, argv, scenario, error)) {
+    std::cerr << error << '\n';
+    return 1;
+  }
+
+  // the statistics go to the file of the scenario as CSV, like the ones of
+  // flock_batch, or else to the standard output as text.
+  std::ofstream statistics_file;
+  if (!scenario.statistics_output.empty()) {
+    statistics_file.open(scenario.statistics_output);
+    if (!statistics_file) {
+      std::cerr << "can't write " << scenario.statistics_output << '\n';
+      return 1;
+    }
+    if (scenario.statistics_every != 0) {
+      pr::write_statistics_header(statistics_file);
+    }
+  }
 
-int main() {
-  std::cout << "Insert the following parameters: \n"
-            << " 1- Parameter which determines when two boids are 'near', "
-               "values permitted are between [50; 200]: \n";
-  float closeness_parameter;
-  std::cin >> closeness_parameter;
-
-  std::cout
-      << " 2- Parameter which represents the distance at which starts to act "
-         "the separation rule among boids, values permitted are between [25; "
-         "40]: \n";
-  float distance_of_separation;
-  std::cin >> distance_of_separation;
-
-  std::cout << " 3- Parameter which determines the intensity of the separation "
-               "among boids, values permitted are between [0.005; 0.8]: \n";
-  float separation_parameter;
-  std::cin >> separation_parameter;
-
-  std::cout << " 4- Parameter which determines the intensity of the allignment "
-               "among boids, values permitted are between [0.2; 0.8]: \n";
-  float allignment_parameter;
-  std::cin >> allignment_parameter;
-
-  std::cout
-      << " 5- Parameter which determines the intensity of the cohesion among "
-         "boids, values permitted are between [0.0001; 0.001]: "
-         "(after you'll have inserted it, you'll be able to start the "
-         "simulation: press the left button of your mouse/touchpad to make a "
-         "boid appear, press the right one to make a predator appear.)\n";
-  float cohesion_parameter;
-  std::cin >> cohesion_parameter;
-
-  sf::RenderWindow window(
-      sf::VideoMode(0.9 * sf::VideoMode::getDesktopMode().width,
-                    0.9 * sf::VideoMode::getDesktopMode().height),
-      "FLOCK SIMULATION");
+  std::cout << "Press the left button of your mouse/touchpad to make a boid "
+               "appear, press the right one to make a predator appear.\n";
 
-  sf::Event event;
+  const unsigned int window_width =
+      scenario.world_width != 0
+          ? scenario.world_width
+          : static_cast<unsigned int>(
+                0.9 * sf::VideoMode::getDesktopMode().width);
+  const unsigned int window_height =
+      scenario.world_height != 0
+          ? scenario.world_height
+          : static_cast<unsigned int>(
+                0.9 * sf::VideoMode::getDesktopMode().height);
 
-  sf::Clock clock1;
-  sf::Clock clock2;
+  sf::RenderWindow window(sf::VideoMode(window_width, window_height),
+                          "FLOCK SIMULATION");
+
+  sf::Event event;
 
   sf::Texture texture;
 
@@ -68,14 +77,48 @@ int main() {
   sprite.setScale(background_scaleX, background_scaleY);
   sprite.setPosition(0.f, 0.f);
 
-  std::random_device r;
-  std::default_random_engine rand_engine(r());
+  // the boids added with the mouse are drawn after the population of the
+  // scenario, from the same seed.
+  std::mt19937 rand_engine{scenario.seed};
   std::normal_distribution<float> velocity_distribution;
   std::uniform_int_distribution<> angle_distribution(120, 180);
 
-  pr::Flock flock{closeness_parameter, distance_of_separation,
-                  separation_parameter, allignment_parameter,
-                  cohesion_parameter};
+  // the flock only stores the physics of the boids: every boid of a species
+  // is drawn with the same shape, moved and rotated where the boid is, and
+  // the renderer draws all of them at once.
+  sf::CircleShape prey_shape{10.f, 3};
+  prey_shape.setScale(1.f, 1.5f);
+  prey_shape.setFillColor(sf::Color::Red);
+  prey_shape.setOrigin(8.6602540f, 7.5f);
+
+  sf::CircleShape predator_shape{15.f, 3};
+  predator_shape.setScale(1.f, 1.5f);
+  predator_shape.setFillColor(sf::Color::Black);
+  predator_shape.setOrigin(12.9903811f, 10.0f);
+
+  pr::Flock_renderer renderer;
+  renderer.set_shape(pr::Species::prey, prey_shape);
+  renderer.set_shape(pr::Species::predator, predator_shape);
+
+  pr::Flock flock = pr::make_flock(scenario, rand_engine);
+
+  // the statistics are computed every statistics_every steps of the
+  // simulation thread, so that each one is the state of the flock at that
+  // very step.
+  flock.set_statistics_cadence(scenario.statistics_every, 0.f);
+
+  // from now on the flock is updated by its own thread, in ticks of the time
+  // step of the scenario (1/60 s by default, at most 5 for every frame), up
+  // to the steps of the scenario, and the window only draws the latest
+  // snapshot it published.
+  pr::Simulation_thread simulation{std::move(flock), window_width,
+                                  window_height, scenario.time_step, 5,
+                                  scenario.steps};
+
+  // the last step whose statistics were written.
+  std::size_t statistics_step{0};
+
+  window.setFramerateLimit(60);
 
   while (window.isOpen()) {
     while (window.pollEvent(event)) {
@@ -99,16 +142,10 @@ int main() {
               float view_angle =
                   static_cast<float>(angle_distribution(rand_engine));
 
-              pr::Boid boid{position_f, speed, 0.5f, view_angle};
-              boid.setPosition(position_f);
-              boid.setRotation();
-              boid.setPointCount();
-              boid.setRadius(10.f);
-              boid.setScale(1.f, 1.5f);
-              boid.setFillColor(sf::Color::Red);
-              boid.setOrigin(8.6602540f, 7.5f);
+              const pr::Boid boid{position_f, speed, 0.5f, view_angle,
+                                  pr::Species::prey};
 
-              flock.push_back(boid);
+              simulation.push_back(boid);
 
               break;
             }
@@ -125,16 +162,10 @@ int main() {
               float view_angle =
                   static_cast<float>(angle_distribution(rand_engine));
 
-              pr::Boid boid{position_f, speed, 0.5f, view_angle};
-              boid.setPosition(position_f);
-              boid.setRotation();
-              boid.setPointCount();
-              boid.setRadius(15.f);
-              boid.setScale(1.f, 1.5f);
-              boid.setFillColor(sf::Color::Black);
-              boid.setOrigin(12.9903811f, 10.0f);
+              const pr::Boid boid{position_f, speed, 0.5f, view_angle,
+                                  pr::Species::predator};
 
-              flock.push_back(boid);
+              simulation.push_back(boid);
 
               break;
             }
@@ -152,33 +183,69 @@ int main() {
       }
     }
 
-    sf::Time time_per_frame = clock1.restart();
-    sf::Time time_passed = clock2.getElapsedTime();
+    const bool new_snapshot = simulation.refresh();
+    const pr::Flock_snapshot& snapshot = simulation.snapshot();
+    const pr::Simulation_state& flock_state = snapshot.state;
 
-    flock.update(time_per_frame, 0.9 * sf::VideoMode::getDesktopMode().width,
-                 0.9 * sf::VideoMode::getDesktopMode().height);
-
-    const pr::Simulation_state flock_state = flock.state();
-
-    if (flock.all_boids().size() >= 2 && time_passed.asSeconds() >= 1.f) {
-      std::cout << "Medium velocity: " << flock_state.medium_velocity << " +/- "
-                << flock_state.err_velocity << ";       "
-                << "Medium distance among boids: "
-                << flock_state.medium_distance << " +/- "
-                << flock_state.err_distance << ";\n";
+    // a scenario with a number of steps closes the window after them.
+    if (scenario.steps != 0 && snapshot.step >= scenario.steps) {
+      window.close();
+    }
 
-      clock2.restart();
+    // the latest statistics are the ones of the last multiple of
+    // statistics_every: when a snapshot skips more than one, only the
+    // latest is written.
+    const std::size_t computed_step =
+        scenario.statistics_every == 0
+            ? 0
+            : snapshot.step / scenario.statistics_every *
+                  scenario.statistics_every;
+
+    if (computed_step > statistics_step && snapshot.boids.size() >= 2) {
+      if (statistics_file.is_open()) {
+        pr::write_statistics(statistics_file, computed_step, flock_state);
+      } else {
+        std::cout << "Medium velocity: " << flock_state.medium_velocity
+                  << " +/- " << flock_state.err_velocity << ";       "
+                  << "Medium distance among boids: "
+                  << flock_state.medium_distance << " +/- "
+                  << flock_state.err_distance << ";\n";
+      }
+      statistics_step = computed_step;
     }
 
     window.clear();
 
     window.draw(sprite);
 
-    for (pr::Boid& boid : flock.all_boids()) {
-      window.draw(boid.set_shape());
+    // the triangles of the boids are only built for a new snapshot, and only
+    // for the boids in the view: the other frames move them along the
+    // interpolation between the last two snapshots.
+    if (new_snapshot == true) {
+      const sf::View& view = window.getView();
+      renderer.update(
+          snapshot.previous_boids, snapshot.boids,
+          sf::FloatRect{view.getCenter().x - view.getSize().x / 2.f,
+                        view.getCenter().y - view.getSize().y / 2.f,
+                        view.getSize().x, view.getSize().y});
     }
+    renderer.interpolate(
+        simulation.interpolation(std::chrono::steady_clock::now()));
+    window.draw(renderer);
 
     window.display();
   }
+
+  // the boids of the last snapshot drawn: with the steps of the scenario,
+  // the ones of its last step.
+  if (!scenario.final_state_output.empty()) {
+    std::ofstream final_state{scenario.final_state_output};
+    if (!final_state) {
+      std::cerr << "can't write " << scenario.final_state_output << '\n';
+      return 1;
+    }
+    pr::write_boids(final_state, simulation.snapshot().boids);
+  }
+
   return 0;
 }
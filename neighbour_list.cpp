@@ -0,0 +1,47 @@
+#include "neighbour_list.hpp"
+
+#include <cassert>
+
+namespace pr {
+Neighbour_list::Neighbour_list(float skin)
+    : skin_{skin}, radius_{0.f}, rebuilds_{0} {
+  assert(skin_ > 0.f);
+}
+
+float Neighbour_list::skin() const { return skin_; }
+
+std::size_t Neighbour_list::size() const { return built_at_.size(); }
+
+std::size_t Neighbour_list::rebuilds() const { return rebuilds_; }
+
+bool Neighbour_list::too_many_displaced() const {
+  const std::size_t max_displaced = 32;
+
+  return displaced_.size() > max_displaced;
+}
+
+bool Neighbour_list::still_valid(std::size_t index,
+                                 const Vector2& position) const {
+  assert(index < size());
+  const float half_skin = 0.5f * skin_;
+
+  return built_at_[index].squared_distance(position) <= half_skin * half_skin;
+}
+
+void Neighbour_list::clear() { built_at_.clear(); }
+
+void Neighbour_list::displace(std::size_t index) {
+  assert(index < size());
+
+  if (is_displaced_[index] == 0) {
+    is_displaced_[index] = 1;
+    displaced_.push_back(index);
+  }
+}
+
+bool Neighbour_list::is_displaced(std::size_t index) const {
+  assert(index < size());
+
+  return is_displaced_[index] == 1;
+}
+}  // namespace pr
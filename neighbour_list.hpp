@@ -0,0 +1,138 @@
+#ifndef NEIGHBOUR_LIST_HPP
+#define NEIGHBOUR_LIST_HPP
+
+#include <cassert>
+#include <vector>
+
+#include "spatial_grid.hpp"
+#include "vector2.hpp"
+
+namespace pr {
+// Verlet lists: for every boid, the boids which were closer than
+// "radius + skin" when the lists were built. As long as no boid moved more
+// than half the skin since then, they hold every pair closer than "radius",
+// so the queries of several updates can be answered without the grid. The
+// few boids which move further (e.g. through the border of the window) are
+// displaced instead, like in the Spatial_grid, until there are too many.
+class Neighbour_list {
+  float skin_;
+
+  float radius_;  // the one of the queries the lists were built for.
+
+  std::vector<std::size_t> first_;  // the neighbours of the i-th boid are
+                                    // neighbours_[first_[i], first_[i + 1]).
+
+  std::vector<std::size_t> neighbours_;
+
+  std::vector<Vector2> built_at_;  // the positions the lists were built on.
+
+  std::vector<unsigned char> is_displaced_;
+
+  std::vector<std::size_t> displaced_;
+
+  std::size_t rebuilds_;
+
+ public:
+  explicit Neighbour_list(float skin);
+
+  float skin() const;
+
+  // number of boids the lists were built for.
+  std::size_t size() const;
+
+  std::size_t rebuilds() const;
+
+  // false if the i-th boid moved more than half the skin since the lists
+  // were built: from then on it has to be displaced.
+  bool still_valid(std::size_t index, const Vector2& position) const;
+
+  // a displaced boid is visited by the queries of every other boid, while
+  // its own queries can't be answered by the lists any more.
+  void displace(std::size_t index);
+
+  bool is_displaced(std::size_t index) const;
+
+  // every query visits all the displaced boids: past a few of them the lists
+  // don't pay off, and have to be rebuilt.
+  bool too_many_displaced() const;
+
+  // displaces the boids which moved too far since the lists were built, and
+  // returns false if the lists have to be rebuilt to answer the queries of
+  // "radius" for the same "number_of_boids" boids, at "position_of(i)".
+  template <typename Position_of>
+  bool refresh(std::size_t number_of_boids, float radius,
+               Position_of position_of) {
+    if (number_of_boids != size() || radius != radius_) {
+      return false;
+    }
+
+    for (std::size_t i{0}; i < number_of_boids; ++i) {
+      if (is_displaced_[i] == 0 && still_valid(i, position_of(i)) == false) {
+        displace(i);
+      }
+    }
+
+    return too_many_displaced() == false;
+  }
+
+  // forgets the lists (e.g. when the boids change index): refresh() asks for
+  // a rebuild, which keeps the memory of the old ones.
+  void clear();
+
+  // builds the lists from "grid", which has to index the same positions.
+  template <typename Position_of>
+  void rebuild(const Spatial_grid& grid, std::size_t number_of_boids,
+               float radius, Position_of position_of) {
+    const float reach = radius + skin_;
+
+    radius_ = radius;
+    first_.resize(number_of_boids + 1);
+    built_at_.resize(number_of_boids);
+    is_displaced_.assign(number_of_boids, 0);
+    displaced_.clear();
+    // every boid can be displaced at most once between two rebuilds.
+    displaced_.reserve(number_of_boids);
+    neighbours_.clear();  // keeps its memory for the next rebuild.
+
+    for (std::size_t i{0}; i < number_of_boids; ++i) {
+      const Vector2 position = position_of(i);
+
+      first_[i] = neighbours_.size();
+      built_at_[i] = position;
+
+      grid.for_each_candidate(
+          position, reach,
+          [this, i, &position, reach, &position_of](std::size_t j) {
+            if (j != i &&
+                position.squared_distance(position_of(j)) < reach * reach) {
+              neighbours_.push_back(j);
+            }
+          });
+    }
+    first_[number_of_boids] = neighbours_.size();
+
+    ++rebuilds_;
+  }
+
+  // calls "function(j)" for every neighbour j of the i-th boid, which must
+  // not be displaced: the caller still has to check the real distance.
+  template <typename Function>
+  void for_each_neighbour(std::size_t index, Function&& function) const {
+    assert(is_displaced_[index] == 0);
+
+    for (std::size_t k{first_[index]}; k < first_[index + 1]; ++k) {
+      const std::size_t neighbour = neighbours_[k];
+
+      if (is_displaced_[neighbour] == 0) {
+        function(neighbour);
+      }
+    }
+
+    for (const std::size_t neighbour : displaced_) {
+      function(neighbour);
+    }
+  }
+};
+}  // namespace pr
+
+#endif
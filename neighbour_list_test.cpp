@@ -0,0 +1,97 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "neighbour_list.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the neighbour lists") {
+  std::vector<pr::Vector2> positions{
+      {50.f, 40.f},   {100.f, 60.f},   {70.f, 90.f},  {130.f, 100.f},
+      {-30.f, -45.f}, {450.f, 460.f},  {99.f, 1.f},   {101.f, 199.f},
+      {249.f, 50.f},  {-150.f, 160.f}, {55.f, 46.f}, {10000.f, 10000.f}};
+  const auto position_of = [&positions](std::size_t i) {
+    return positions[i];
+  };
+
+  pr::Spatial_grid grid{100.f};
+  grid.rebuild(positions.size(), position_of);
+
+  pr::Neighbour_list lists{20.f};
+  CHECK(lists.refresh(positions.size(), 100.f, position_of) == false);
+
+  lists.rebuild(grid, positions.size(), 100.f, position_of);
+
+  CHECK(lists.size() == 12);
+  CHECK(lists.rebuilds() == 1);
+  CHECK(lists.refresh(positions.size(), 100.f, position_of) == true);
+  CHECK(lists.too_many_displaced() == false);
+
+  SUBCASE("Every other boid closer than radius + skin is listed once:") {
+    for (std::size_t i{0}; i < positions.size(); ++i) {
+      std::vector<std::size_t> listed;
+      lists.for_each_neighbour(
+          i, [&listed](std::size_t j) { listed.push_back(j); });
+      std::sort(listed.begin(), listed.end());
+
+      std::vector<std::size_t> expected;
+      for (std::size_t j{0}; j < positions.size(); ++j) {
+        if (j != i && positions[i].distance(positions[j]) < 120.f) {
+          expected.push_back(j);
+        }
+      }
+
+      CHECK(listed == expected);
+    }
+  }
+
+  SUBCASE("A boid which moves more than half the skin is displaced:") {
+    positions[3] += pr::Vector2{6.f, -8.f};
+    CHECK(lists.still_valid(3, positions[3]) == true);
+    CHECK(lists.refresh(positions.size(), 100.f, position_of) == true);
+    CHECK(lists.is_displaced(3) == false);
+
+    positions[3] += pr::Vector2{0.f, -1.f};
+    CHECK(lists.still_valid(3, positions[3]) == false);
+    CHECK(lists.refresh(positions.size(), 100.f, position_of) == true);
+    CHECK(lists.is_displaced(3) == true);
+
+    // every other boid visits it once, wherever it went.
+    for (std::size_t i{0}; i < positions.size(); ++i) {
+      if (i != 3) {
+        std::size_t visits{0};
+        lists.for_each_neighbour(i, [&visits](std::size_t j) {
+          visits += j == 3 ? 1 : 0;
+        });
+
+        CHECK(visits == 1);
+      }
+    }
+  }
+
+  SUBCASE("The lists have to be rebuilt when too many boids moved:") {
+    for (pr::Vector2& position : positions) {
+      position += pr::Vector2{0.f, 11.f};
+    }
+    const std::vector<pr::Vector2> moved = positions;
+
+    for (int copy{0}; copy < 3; ++copy) {
+      positions.insert(positions.end(), moved.begin(), moved.end());
+    }
+    grid.rebuild(positions.size(), position_of);
+    lists.rebuild(grid, positions.size(), 100.f, position_of);
+    CHECK(lists.refresh(positions.size(), 100.f, position_of) == true);
+
+    for (pr::Vector2& position : positions) {
+      position += pr::Vector2{11.f, 0.f};
+    }
+    CHECK(lists.refresh(positions.size(), 100.f, position_of) == false);
+    CHECK(lists.too_many_displaced() == true);
+  }
+
+  SUBCASE("The lists don't hold for other radii or numbers of boids:") {
+    CHECK(lists.refresh(positions.size(), 50.f, position_of) == false);
+    CHECK(lists.refresh(positions.size() - 1, 100.f, position_of) == false);
+  }
+}
@@ -0,0 +1,395 @@
+#include "scenario.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+namespace pr {
+namespace {
+std::string trimmed(const std::string& text) {
+  const std::size_t first = text.find_first_not_of(" \t\r");
+  if (first == std::string::npos) {
+    return "";
+  }
+  const std::size_t last = text.find_last_not_of(" \t\r");
+
+  return text.substr(first, last - first + 1);
+}
+
+// the whole text has to be the number: "12abc" is not 12.
+bool to_float(const std::string& text, float& value) {
+  char* end{nullptr};
+  const float number = std::strtof(text.c_str(), &end);
+  if (text.empty() || *end != '\0' || !std::isfinite(number)) {
+    return false;
+  }
+  value = number;
+
+  return true;
+}
+
+bool to_double(const std::string& text, double& value) {
+  char* end{nullptr};
+  const double number = std::strtod(text.c_str(), &end);
+  if (text.empty() || *end != '\0' || !std::isfinite(number)) {
+    return false;
+  }
+  value = number;
+
+  return true;
+}
+
+bool to_size(const std::string& text, std::size_t& value) {
+  if (text.empty() || text.find('-') != std::string::npos) {
+    return false;
+  }
+  char* end{nullptr};
+  const unsigned long long number = std::strtoull(text.c_str(), &end, 10);
+  if (*end != '\0' || number > std::numeric_limits<std::size_t>::max()) {
+    return false;
+  }
+  value = static_cast<std::size_t>(number);
+
+  return true;
+}
+
+template <typename Unsigned>
+bool to_unsigned(const std::string& text, Unsigned& value) {
+  std::size_t wide{0};
+  if (!to_size(text, wide) || wide > std::numeric_limits<Unsigned>::max()) {
+    return false;
+  }
+  value = static_cast<Unsigned>(wide);
+
+  return true;
+}
+
+bool in_range(const std::string& key, const std::string& value, float minimum,
+              float maximum, float& parameter, std::string& error) {
+  float number{0.f};
+  if (!to_float(value, number) || number < minimum || number > maximum) {
+    std::ostringstream message;
+    message << key << " has to be a number in [" << minimum << "; "
+            << maximum << "], not \"" << value << "\"";
+    error = message.str();
+
+    return false;
+  }
+  parameter = number;
+
+  return true;
+}
+
+// the other species of a flock are written as their number.
+std::string name_of(Species species) {
+  switch (species) {
+    case Species::prey:
+      return "prey";
+    case Species::predator:
+      return "predator";
+    default:
+      return std::to_string(static_cast<int>(species));
+  }
+}
+
+// "species shape (numbers of the shape) count", optionally followed by
+// "velocity_deviation maximum_velocity min_view_angle max_view_angle".
+bool to_spawn_spec(const std::string& value, Spawn_spec& spec,
+                   std::string& error) {
+  std::istringstream stream{value};
+  std::vector<std::string> words;
+  for (std::string word; stream >> word;) {
+    words.push_back(word);
+  }
+
+  if (words.size() < 2) {
+    error = "spawn needs a species, a shape and a count";
+    return false;
+  }
+
+  Species species{Species::prey};
+  if (words[0] == "predator") {
+    species = Species::predator;
+  } else if (words[0] != "prey") {
+    error = "the species of spawn is prey or predator, not \"" + words[0] +
+            "\"";
+    return false;
+  }
+
+  std::size_t shape_numbers{0};
+  if (words[1] == "box" || words[1] == "ring") {
+    shape_numbers = 4;
+  } else if (words[1] == "gaussian") {
+    shape_numbers = 3;
+  } else {
+    error = "the shape of spawn is box, gaussian or ring, not \"" + words[1] +
+            "\"";
+    return false;
+  }
+
+  const std::size_t count_word = 2 + shape_numbers;
+  if (words.size() != count_word + 1 && words.size() != count_word + 5) {
+    error = "spawn " + words[1] + " needs " + std::to_string(shape_numbers) +
+            " numbers, a count and optionally the velocity deviation, the "
+            "maximum velocity and the range of the view angle";
+    return false;
+  }
+
+  // the defaults of the boids added with the mouse.
+  float numbers[8]{0.f, 0.f, 0.f, 0.f, 1.f, 0.5f, 120.f, 180.f};
+  for (std::size_t k{0}; k < shape_numbers; ++k) {
+    if (!to_float(words[2 + k], numbers[k])) {
+      error = "\"" + words[2 + k] + "\" is not a number";
+      return false;
+    }
+  }
+  for (std::size_t k{count_word + 1}; k < words.size(); ++k) {
+    if (!to_float(words[k], numbers[4 + k - count_word - 1])) {
+      error = "\"" + words[k] + "\" is not a number";
+      return false;
+    }
+  }
+
+  std::size_t count{0};
+  if (!to_size(words[count_word], count)) {
+    error = "the count of spawn has to be an integer, not \"" +
+            words[count_word] + "\"";
+    return false;
+  }
+
+  if (numbers[4] < 0.f || numbers[5] <= 0.f || numbers[6] < 0.f ||
+      numbers[6] > numbers[7] || numbers[7] > 180.f) {
+    error =
+        "spawn needs a velocity deviation >= 0, a maximum velocity > 0 and "
+        "view angles with 0 <= min <= max <= 180";
+    return false;
+  }
+
+  if (words[1] == "box") {
+    if (numbers[0] > numbers[2] || numbers[1] > numbers[3]) {
+      error = "spawn box needs x_min y_min x_max y_max";
+      return false;
+    }
+    spec.area = Spawn_area::box(Vector2{numbers[0], numbers[1]},
+                                Vector2{numbers[2], numbers[3]});
+
+  } else if (words[1] == "gaussian") {
+    if (numbers[2] < 0.f) {
+      error = "spawn gaussian needs x y deviation, with deviation >= 0";
+      return false;
+    }
+    spec.area = Spawn_area::gaussian(Vector2{numbers[0], numbers[1]},
+                                     numbers[2]);
+
+  } else {
+    if (numbers[2] < 0.f || numbers[2] > numbers[3]) {
+      error = "spawn ring needs x y inner outer, with 0 <= inner <= outer";
+      return false;
+    }
+    spec.area =
+        Spawn_area::ring(Vector2{numbers[0], numbers[1]}, numbers[2],
+                         numbers[3]);
+  }
+
+  spec.count = count;
+  spec.species = species;
+  spec.velocity_deviation = numbers[4];
+  spec.maximum_velocity = numbers[5];
+  spec.min_view_angle = numbers[6];
+  spec.max_view_angle = numbers[7];
+
+  return true;
+}
+}  // namespace
+
+bool set_option(Scenario& scenario, const std::string& key,
+                const std::string& value, std::string& error) {
+  // the ranges asserted by the constructor of Flock.
+  if (key == "closeness") {
+    return in_range(key, value, 50.f, 200.f, scenario.closeness, error);
+  }
+  if (key == "separation_distance") {
+    return in_range(key, value, 25.f, 40.f, scenario.separation_distance,
+                    error);
+  }
+  if (key == "separation") {
+    return in_range(key, value, 0.005f, 0.08f, scenario.separation, error);
+  }
+  if (key == "allignment") {
+    return in_range(key, value, 0.2f, 0.8f, scenario.allignment, error);
+  }
+  if (key == "cohesion") {
+    return in_range(key, value, 0.0001f, 0.001f, scenario.cohesion, error);
+  }
+
+  bool valid{true};
+  if (key == "width") {
+    unsigned int width{0};
+    valid = to_unsigned(value, width) && width > 0;
+    scenario.world_width = valid ? width : scenario.world_width;
+  } else if (key == "height") {
+    unsigned int height{0};
+    valid = to_unsigned(value, height) && height > 0;
+    scenario.world_height = valid ? height : scenario.world_height;
+  } else if (key == "spawn") {
+    Spawn_spec spec{Spawn_area::box(Vector2{}, Vector2{}), 0, Species::prey,
+                    0.f, 0.f, 0.f, 0.f};
+    if (!to_spawn_spec(value, spec, error)) {
+      return false;
+    }
+    scenario.population.push_back(spec);
+  } else if (key == "seed") {
+    valid = to_unsigned(value, scenario.seed);
+  } else if (key == "steps") {
+    valid = to_size(value, scenario.steps);
+  } else if (key == "time_step") {
+    double time_step{0.};
+    valid = to_double(value, time_step) && time_step > 0.;
+    scenario.time_step = valid ? time_step : scenario.time_step;
+  } else if (key == "threads") {
+    valid = to_unsigned(value, scenario.threads);
+  } else if (key == "skin") {
+    float skin{0.f};
+    valid = to_float(value, skin) && skin >= 0.f;
+    scenario.neighbour_skin = valid ? skin : scenario.neighbour_skin;
+  } else if (key == "reorder") {
+    valid = to_size(value, scenario.reordering);
+  } else if (key == "statistics") {
+    valid = value == "exact" || value == "sampled";
+    if (valid) {
+      scenario.statistics_mode = value == "exact" ? Statistics_mode::exact
+                                                  : Statistics_mode::sampled;
+    }
+  } else if (key == "statistics_every") {
+    valid = to_size(value, scenario.statistics_every);
+  } else if (key == "statistics_output") {
+    scenario.statistics_output = value;
+  } else if (key == "final_state") {
+    scenario.final_state_output = value;
+  } else {
+    error = "unknown option \"" + key + "\"";
+    return false;
+  }
+
+  if (!valid) {
+    error = "\"" + value + "\" is not a valid value of " + key;
+  }
+
+  return valid;
+}
+
+bool read_scenario(std::istream& input, Scenario& scenario,
+                   std::string& error) {
+  std::size_t line_number{0};
+  for (std::string line; std::getline(input, line);) {
+    ++line_number;
+
+    const std::string content = trimmed(line.substr(0, line.find('#')));
+    if (content.empty()) {
+      continue;
+    }
+
+    const std::size_t equals = content.find('=');
+    if (equals == std::string::npos) {
+      error = "line " + std::to_string(line_number) + ": \"key = value\" expected";
+      return false;
+    }
+
+    if (!set_option(scenario, trimmed(content.substr(0, equals)),
+                    trimmed(content.substr(equals + 1)), error)) {
+      error = "line " + std::to_string(line_number) + ": " + error;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool parse_arguments(int argc, const char* const argv[], Scenario& scenario,
+                     std::string& error) {
+  for (int i{1}; i < argc; i += 2) {
+    const std::string flag{argv[i]};
+    if (flag.size() < 3 || flag.compare(0, 2, "--") != 0) {
+      error = "options are written \"--key value\", not \"" + flag + "\"";
+      return false;
+    }
+    if (i + 1 >= argc) {
+      error = flag + " needs a value";
+      return false;
+    }
+
+    const std::string key = flag.substr(2);
+    const std::string value{argv[i + 1]};
+
+    if (key == "scenario") {
+      std::ifstream file{value};
+      if (!file) {
+        error = "can't open the scenario " + value;
+        return false;
+      }
+      if (!read_scenario(file, scenario, error)) {
+        error = value + ", " + error;
+        return false;
+      }
+
+    } else if (!set_option(scenario, key, value, error)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Flock make_flock(const Scenario& scenario, std::mt19937& engine) {
+  Flock flock{scenario.closeness, scenario.separation_distance,
+              scenario.separation, scenario.allignment, scenario.cohesion};
+
+  // the double buffered update gives the same flock whatever the number of
+  // threads.
+  flock.set_update_mode(Update_mode::double_buffered);
+  flock.set_thread_count(scenario.threads == 0
+                             ? std::max(1u, std::thread::hardware_concurrency())
+                             : scenario.threads);
+  flock.set_statistics_mode(scenario.statistics_mode);
+  flock.set_neighbour_skin(scenario.neighbour_skin);
+  flock.set_reordering(scenario.reordering);
+
+  for (const Spawn_spec& spec : scenario.population) {
+    flock.spawn(spec, engine);
+  }
+
+  return flock;
+}
+
+void write_statistics_header(std::ostream& output) {
+  output << "step,medium_velocity,err_velocity,medium_distance,err_distance\n";
+}
+
+void write_statistics(std::ostream& output, std::size_t step,
+                      const Simulation_state& state) {
+  output << step << ',' << state.medium_velocity << ',' << state.err_velocity
+         << ',' << state.medium_distance << ',' << state.err_distance << '\n';
+}
+
+void write_boids(std::ostream& output, const Boid_store& boids) {
+  const auto precision = output.precision(9);
+
+  output << "id,species,x,y,velocity_x,velocity_y\n";
+  for (std::size_t i{0}; i < boids.size(); ++i) {
+    const Boid_view boid = boids[i];
+
+    output << boid.id() << ',' << name_of(boid.species()) << ','
+           << boid.position().x_axis() << ',' << boid.position().y_axis()
+           << ',' << boid.velocity().x_axis() << ','
+           << boid.velocity().y_axis() << '\n';
+  }
+
+  output.precision(precision);
+}
+}  // namespace pr
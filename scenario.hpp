@@ -0,0 +1,88 @@
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "flock.hpp"
+#include "spawn.hpp"
+
+namespace pr {
+// everything a run of the simulation depends on: the same scenario gives
+// the same run, with or without a window.
+struct Scenario {
+  // the parameters of the flock, in the ranges Flock accepts.
+  float closeness{100.f};
+
+  float separation_distance{30.f};
+
+  float separation{0.05f};
+
+  float allignment{0.5f};
+
+  float cohesion{0.0005f};
+
+  unsigned int world_width{0};  // 0: the viewer fills 90% of the screen.
+
+  unsigned int world_height{0};
+
+  std::vector<Spawn_spec> population;
+
+  std::uint32_t seed{1};  // of the population, and of the boids added later.
+
+  std::size_t steps{0};  // 0: until the window is closed.
+
+  double time_step{1. / 60.};  // seconds of simulation of every step.
+
+  unsigned int threads{0};  // 0: one for every core.
+
+  float neighbour_skin{0.f};
+
+  std::size_t reordering{0};
+
+  Statistics_mode statistics_mode{Statistics_mode::sampled};
+
+  std::size_t statistics_every{60};  // steps between two lines of statistics
+                                     // (0: none).
+
+  std::string statistics_output;  // empty: the standard output.
+
+  std::string final_state_output;  // empty: the final boids aren't written.
+};
+
+// sets the option "key" of the scenario to "value", the way it is written
+// in a scenario file; "spawn" adds to the population instead. Returns false,
+// and says why in "error", if the key is unknown or the value isn't valid.
+bool set_option(Scenario& scenario, const std::string& key,
+                const std::string& value, std::string& error);
+
+// one "key = value" for every line, where '#' starts a comment. A key given
+// twice keeps the latter value.
+bool read_scenario(std::istream& input, Scenario& scenario,
+                   std::string& error);
+
+// "--scenario FILE" reads a scenario file, "--key value" sets a single
+// option: they are applied in order, so that the flags after a file change
+// it.
+bool parse_arguments(int argc, const char* const argv[], Scenario& scenario,
+                     std::string& error);
+
+// the flock of the scenario, with its population drawn from "engine".
+Flock make_flock(const Scenario& scenario, std::mt19937& engine);
+
+// the header of the statistics of a run, and their line at "step", as CSV.
+void write_statistics_header(std::ostream& output);
+
+void write_statistics(std::ostream& output, std::size_t step,
+                      const Simulation_state& state);
+
+// every boid of the flock as a line "id,species,x,y,velocity_x,velocity_y",
+// after a header.
+void write_boids(std::ostream& output, const Boid_store& boids);
+}  // namespace pr
+
+#endif
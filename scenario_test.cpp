@@ -0,0 +1,258 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "scenario.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the options of a scenario") {
+  pr::Scenario scenario;
+  std::string error;
+
+  CHECK(pr::set_option(scenario, "closeness", "150", error) == true);
+  CHECK(scenario.closeness == 150.f);
+  CHECK(pr::set_option(scenario, "steps", "600", error) == true);
+  CHECK(scenario.steps == 600);
+  CHECK(pr::set_option(scenario, "statistics", "exact", error) == true);
+  CHECK(scenario.statistics_mode == pr::Statistics_mode::exact);
+
+  SUBCASE("Values out of the ranges of the flock are refused:") {
+    CHECK(pr::set_option(scenario, "closeness", "300", error) == false);
+    CHECK(error == "closeness has to be a number in [50; 200], not \"300\"");
+    CHECK(scenario.closeness == 150.f);
+
+    CHECK(pr::set_option(scenario, "cohesion", "0.01", error) == false);
+    CHECK(pr::set_option(scenario, "width", "0", error) == false);
+    CHECK(pr::set_option(scenario, "steps", "-5", error) == false);
+    CHECK(pr::set_option(scenario, "steps", "12abc", error) == false);
+    CHECK(scenario.steps == 600);
+    CHECK(pr::set_option(scenario, "time_step", "0", error) == false);
+    CHECK(pr::set_option(scenario, "statistics", "approximate", error) ==
+          false);
+  }
+
+  SUBCASE("Unknown options are refused:") {
+    CHECK(pr::set_option(scenario, "colour", "red", error) == false);
+    CHECK(error == "unknown option \"colour\"");
+  }
+
+  SUBCASE("Every spawn adds to the population:") {
+    CHECK(pr::set_option(scenario, "spawn", "prey box 0 10 800 600 500",
+                         error) == true);
+    CHECK(pr::set_option(scenario, "spawn",
+                         "predator ring 400 300 50 100 5 2 0.8 90 120",
+                         error) == true);
+    REQUIRE(scenario.population.size() == 2);
+
+    const pr::Spawn_spec& prey = scenario.population[0];
+    CHECK(prey.area.shape() == pr::Spawn_shape::box);
+    CHECK(prey.area.centre() == pr::Vector2{400.f, 305.f});
+    CHECK(prey.count == 500);
+    CHECK(prey.species == pr::Species::prey);
+    CHECK(prey.maximum_velocity == 0.5f);
+    CHECK(prey.min_view_angle == 120.f);
+
+    const pr::Spawn_spec& predators = scenario.population[1];
+    CHECK(predators.area.shape() == pr::Spawn_shape::ring);
+    CHECK(predators.area.size() == pr::Vector2{50.f, 100.f});
+    CHECK(predators.count == 5);
+    CHECK(predators.species == pr::Species::predator);
+    CHECK(predators.velocity_deviation == 2.f);
+    CHECK(predators.maximum_velocity == 0.8f);
+    CHECK(predators.max_view_angle == 120.f);
+  }
+
+  SUBCASE("Malformed spawns are refused:") {
+    CHECK(pr::set_option(scenario, "spawn", "bird box 0 0 1 1 5", error) ==
+          false);
+    CHECK(pr::set_option(scenario, "spawn", "prey gaussian 0 0 5", error) ==
+          false);
+    CHECK(pr::set_option(scenario, "spawn", "prey box 10 0 0 10 5", error) ==
+          false);
+    CHECK(pr::set_option(scenario, "spawn", "prey ring 0 0 20 10 5", error) ==
+          false);
+    CHECK(pr::set_option(scenario, "spawn", "prey gaussian 0 0 5 10 1 1 90 200",
+                         error) == false);
+    CHECK(scenario.population.empty() == true);
+  }
+}
+
+TEST_CASE("Testing the scenario files") {
+  pr::Scenario scenario;
+  std::string error;
+
+  SUBCASE("Comments and blank lines are skipped:") {
+    std::istringstream file{
+        "# a flock in a box\n"
+        "\n"
+        "closeness = 120   # pixels\n"
+        "width=800\n"
+        "  height = 600\n"
+        "seed = 7\n"
+        "spawn = prey gaussian 400 300 50 1000\n"
+        "statistics_output = run.csv\n"};
+
+    CHECK(pr::read_scenario(file, scenario, error) == true);
+    CHECK(scenario.closeness == 120.f);
+    CHECK(scenario.world_width == 800);
+    CHECK(scenario.world_height == 600);
+    CHECK(scenario.seed == 7);
+    CHECK(scenario.population.size() == 1);
+    CHECK(scenario.statistics_output == "run.csv");
+  }
+
+  SUBCASE("The errors say their line:") {
+    std::istringstream file{"steps = 10\n\nseparation = 1\n"};
+
+    CHECK(pr::read_scenario(file, scenario, error) == false);
+    CHECK(error ==
+          "line 3: separation has to be a number in [0.005; 0.08], not \"1\"");
+  }
+
+  SUBCASE("A line has to be a key and a value:") {
+    std::istringstream file{"steps 10\n"};
+
+    CHECK(pr::read_scenario(file, scenario, error) == false);
+    CHECK(error == "line 1: \"key = value\" expected");
+  }
+}
+
+TEST_CASE("Testing the command line") {
+  // out of the working directory, and removed at the end of every subcase.
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "scenario_test.scenario")
+          .string();
+  {
+    std::ofstream file{path};
+    file << "steps = 100\nseed = 3\nspawn = prey box 0 0 100 100 10\n";
+  }
+  pr::Scenario scenario;
+  std::string error;
+
+  SUBCASE("The flags after a file change it:") {
+    const char* arguments[]{"flock", "--scenario", path.c_str(), "--steps",
+                            "50"};
+
+    CHECK(pr::parse_arguments(5, arguments, scenario, error) == true);
+    CHECK(scenario.steps == 50);
+    CHECK(scenario.seed == 3);
+    CHECK(scenario.population.size() == 1);
+  }
+
+  SUBCASE("The flags before a file are changed by it:") {
+    const char* arguments[]{"flock", "--steps", "50", "--scenario",
+                            path.c_str()};
+
+    CHECK(pr::parse_arguments(5, arguments, scenario, error) == true);
+    CHECK(scenario.steps == 100);
+  }
+
+  SUBCASE("Malformed command lines are refused:") {
+    const char* missing_value[]{"flock", "--steps"};
+    CHECK(pr::parse_arguments(2, missing_value, scenario, error) == false);
+    CHECK(error == "--steps needs a value");
+
+    const char* no_dashes[]{"flock", "steps", "10"};
+    CHECK(pr::parse_arguments(3, no_dashes, scenario, error) == false);
+
+    const char* missing_file[]{"flock", "--scenario", "missing.scenario"};
+    CHECK(pr::parse_arguments(3, missing_file, scenario, error) == false);
+    CHECK(error == "can't open the scenario missing.scenario");
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Testing the flock of a scenario") {
+  pr::Scenario scenario;
+  std::string error;
+  std::istringstream file{
+      "threads = 2\n"
+      "spawn = prey box 0 0 400 300 200\n"
+      "spawn = predator gaussian 200 150 20 3\n"};
+  REQUIRE(pr::read_scenario(file, scenario, error) == true);
+
+  std::mt19937 engine{scenario.seed};
+  pr::Flock flock = pr::make_flock(scenario, engine);
+
+  CHECK(flock.size() == 203);
+  CHECK(flock.thread_count() == 2);
+  CHECK(flock.update_mode() == pr::Update_mode::double_buffered);
+  CHECK(flock.boids()[202].species() == pr::Species::predator);
+
+  SUBCASE("The same scenario gives the same run:") {
+    std::mt19937 same_engine{scenario.seed};
+    pr::Flock same_flock = pr::make_flock(scenario, same_engine);
+
+    for (int step{0}; step < 10; ++step) {
+      flock.update(1.f / 60.f, 400, 300);
+      same_flock.update(1.f / 60.f, 400, 300);
+    }
+
+    std::ostringstream boids;
+    std::ostringstream same_boids;
+    pr::write_boids(boids, flock.boids());
+    pr::write_boids(same_boids, same_flock.boids());
+
+    CHECK(boids.str() == same_boids.str());
+  }
+
+  SUBCASE("The number of threads doesn't change the run:") {
+    pr::Scenario single = scenario;
+    pr::Scenario threaded = scenario;
+    single.threads = 1;
+    threaded.threads = 4;
+
+    std::mt19937 single_engine{scenario.seed};
+    std::mt19937 threaded_engine{scenario.seed};
+    pr::Flock single_flock = pr::make_flock(single, single_engine);
+    pr::Flock threaded_flock = pr::make_flock(threaded, threaded_engine);
+
+    CHECK(single_flock.thread_count() == 1);
+    CHECK(threaded_flock.thread_count() == 4);
+
+    for (int step{0}; step < 30; ++step) {
+      single_flock.update(1.f / 60.f, 400, 300);
+      threaded_flock.update(1.f / 60.f, 400, 300);
+    }
+
+    std::ostringstream single_boids;
+    std::ostringstream threaded_boids;
+    pr::write_boids(single_boids, single_flock.boids());
+    pr::write_boids(threaded_boids, threaded_flock.boids());
+
+    CHECK(single_boids.str() == threaded_boids.str());
+  }
+
+  SUBCASE("The statistics are written as CSV:") {
+    std::ostringstream statistics;
+    pr::write_statistics_header(statistics);
+    pr::write_statistics(statistics, 60,
+                         pr::Simulation_state{1.5f, 0.25f, 120.f, 40.f});
+
+    CHECK(statistics.str() ==
+          "step,medium_velocity,err_velocity,medium_distance,err_distance\n"
+          "60,1.5,0.25,120,40\n");
+  }
+
+  SUBCASE("The boids are written one for every line:") {
+    std::ostringstream boids;
+    pr::write_boids(boids, flock.boids());
+
+    std::istringstream lines{boids.str()};
+    std::string line;
+    std::getline(lines, line);
+    CHECK(line == "id,species,x,y,velocity_x,velocity_y");
+
+    std::size_t count{0};
+    while (std::getline(lines, line)) {
+      ++count;
+    }
+    CHECK(count == 203);
+  }
+}
@@ -0,0 +1,109 @@
+#include "simulation_thread.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace pr {
+Simulation_thread::Simulation_thread(Flock flock, unsigned int window_height,
+                                     unsigned int window_width, double tick,
+                                     std::size_t max_ticks,
+                                     std::size_t last_step)
+    : flock_{std::move(flock)},
+      window_height_{window_height},
+      window_width_{window_width},
+      clock_{tick, max_ticks},
+      last_step_{last_step},
+      real_time_{true},
+      running_{true} {
+  // started last, when everything it uses is ready.
+  thread_ = std::thread{[this] { run(); }};
+}
+
+Simulation_thread::~Simulation_thread() {
+  running_.store(false, std::memory_order_release);
+  thread_.join();
+}
+
+void Simulation_thread::push_back(const Boid& new_boid) {
+  const std::lock_guard<std::mutex> lock{new_boids_mutex_};
+  new_boids_.push_back(new_boid);
+}
+
+void Simulation_thread::set_real_time(bool real_time) {
+  real_time_.store(real_time, std::memory_order_relaxed);
+}
+
+double Simulation_thread::tick() const { return clock_.tick(); }
+
+bool Simulation_thread::refresh() { return snapshots_.refresh(); }
+
+const Flock_snapshot& Simulation_thread::snapshot() const {
+  return snapshots_.front();
+}
+
+float Simulation_thread::interpolation(
+    std::chrono::steady_clock::time_point now) const {
+  const double ticks_passed =
+      seconds_between(snapshot().published, now) / clock_.tick();
+
+  return static_cast<float>(std::clamp(ticks_passed, 0., 1.));
+}
+
+void Simulation_thread::run() {
+  using clock = std::chrono::steady_clock;
+
+  auto previous_frame = clock::now();
+  std::size_t step{0};
+
+  while (running_.load(std::memory_order_acquire)) {
+    {
+      const std::lock_guard<std::mutex> lock{new_boids_mutex_};
+
+      for (const Boid& new_boid : new_boids_) {
+        flock_.push_back(new_boid);
+      }
+      new_boids_.clear();
+    }
+
+    const auto now = clock::now();
+    std::size_t ticks =
+        real_time_.load(std::memory_order_relaxed) == true
+            ? clock_.advance(seconds_between(previous_frame, now))
+            : 1;
+    previous_frame = now;
+
+    if (last_step_ != 0) {
+      ticks = std::min(ticks, last_step_ - step);
+    }
+
+    if (ticks != 0) {
+      // the buffers of the snapshots keep their memory, so copying the flock
+      // doesn't allocate unless it grew.
+      Flock_snapshot& snapshot = snapshots_.back();
+
+      for (std::size_t t{0}; t < ticks; ++t) {
+        if (t + 1 == ticks) {
+          snapshot.previous_boids = flock_.boids();
+        }
+
+        flock_.update(static_cast<float>(clock_.tick()), window_height_,
+                      window_width_);
+      }
+      step += ticks;
+
+      snapshot.boids = flock_.boids();
+      snapshot.step = step;
+      snapshot.state = flock_.latest_state();
+      snapshot.published = clock::now();
+      snapshots_.publish();
+    }
+
+    // after the last step there is nothing left to do but waiting.
+    if (real_time_.load(std::memory_order_relaxed) == true || ticks == 0) {
+      // sleeps until the next tick is due.
+      std::this_thread::sleep_for(std::chrono::duration<double>{
+          (1. - clock_.alpha()) * clock_.tick()});
+    }
+  }
+}
+}  // namespace pr
@@ -0,0 +1,95 @@
+#ifndef SIMULATION_THREAD_HPP
+#define SIMULATION_THREAD_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fixed_step_clock.hpp"
+#include "flock.hpp"
+#include "triple_buffer.hpp"
+
+namespace pr {
+// what the simulation thread publishes after its ticks: a copy of the flock
+// which doesn't change while it is read.
+struct Flock_snapshot {
+  Boid_store boids;
+
+  Boid_store previous_boids;  // the flock one tick before "boids", to draw
+                              // the boids between the two.
+
+  Simulation_state state{0.f, 0.f, 0.f, 0.f};  // the latest ones computed
+                                               // by the cadence of the flock.
+
+  std::size_t step{0};  // number of ticks before this snapshot (0 until the
+                        // first one is published).
+
+  std::chrono::steady_clock::time_point published;
+};
+
+// runs the updates of a flock on its own thread, in ticks of "tick" seconds
+// (at most "max_ticks" at a time), so that a slow step doesn't slow down the
+// window and a slow frame doesn't slow down the simulation. The flock can
+// only be seen through the snapshots. With a "last_step" the flock stops
+// after that many ticks (0: never).
+class Simulation_thread {
+  Flock flock_;
+
+  const unsigned int window_height_;
+
+  const unsigned int window_width_;
+
+  Fixed_step_clock clock_;
+
+  const std::size_t last_step_;
+
+  std::atomic<bool> real_time_;
+
+  Triple_buffer<Flock_snapshot> snapshots_;
+
+  std::mutex new_boids_mutex_;
+
+  std::vector<Boid> new_boids_;  // added to the flock before the next step.
+
+  std::atomic<bool> running_;
+
+  std::thread thread_;
+
+  void run();
+
+ public:
+  Simulation_thread(Flock flock, unsigned int window_height,
+                    unsigned int window_width, double tick,
+                    std::size_t max_ticks, std::size_t last_step = 0);
+
+  ~Simulation_thread();
+
+  Simulation_thread(const Simulation_thread&) = delete;
+
+  Simulation_thread& operator=(const Simulation_thread&) = delete;
+
+  // can be called from any thread.
+  void push_back(const Boid& new_boid);
+
+  // out of real time (e.g. when nothing is drawn) the ticks follow each other
+  // as fast as the flock can be updated. It can be called from any thread.
+  void set_real_time(bool real_time);
+
+  double tick() const;
+
+  // the two functions below belong to a single reader thread: refresh()
+  // moves snapshot() to the latest step, and returns false if there was
+  // none since the previous call.
+  bool refresh();
+
+  const Flock_snapshot& snapshot() const;
+
+  // how far "now" is between snapshot().previous_boids (0) and
+  // snapshot().boids (1), assuming the next tick arrives on time.
+  float interpolation(std::chrono::steady_clock::time_point now) const;
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,109 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "simulation_thread.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "doctest.h"
+
+namespace {
+// waits for a snapshot which satisfies "condition", for at most five seconds.
+template <typename Condition>
+bool wait_for(pr::Simulation_thread& simulation, Condition condition) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (simulation.refresh() && condition(simulation.snapshot())) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return false;
+}
+}  // namespace
+
+TEST_CASE("Testing the Simulation_thread class") {
+  pr::Flock flock{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+  flock.push_back(pr::Boid{pr::Vector2{100.f, 100.f}, pr::Vector2{1.f, 2.f},
+                           10.f, 150.f});
+  flock.push_back(pr::Boid{pr::Vector2{150.f, 120.f}, pr::Vector2{-1.f, 1.f},
+                           10.f, 150.f});
+  flock.push_back(pr::Boid{pr::Vector2{120.f, 160.f}, pr::Vector2{2.f, -1.f},
+                           10.f, 150.f});
+
+  pr::Simulation_thread simulation{std::move(flock), 800, 600, 0.001, 5};
+
+  SUBCASE("The steps are published:") {
+    CHECK(wait_for(simulation, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.step >= 3 && snapshot.boids.size() == 3;
+    }));
+  }
+
+  SUBCASE("New boids join the flock:") {
+    simulation.push_back(pr::Boid{pr::Vector2{400.f, 300.f},
+                                  pr::Vector2{1.f, 1.f}, 10.f, 150.f,
+                                  pr::Species::predator});
+
+    CHECK(wait_for(simulation, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.boids.size() == 4 &&
+             snapshot.boids.species(3) == pr::Species::predator;
+    }));
+  }
+
+  SUBCASE("The snapshot doesn't change until the next refresh():") {
+    REQUIRE(wait_for(simulation, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.step >= 1;
+    }));
+
+    const pr::Boid first = simulation.snapshot().boids.boid(0);
+    const std::size_t step = simulation.snapshot().step;
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    CHECK(simulation.snapshot().boids.boid(0) == first);
+    CHECK(simulation.snapshot().step == step);
+  }
+
+  SUBCASE("Every snapshot keeps the flock of the tick before:") {
+    REQUIRE(wait_for(simulation, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.step >= 2;
+    }));
+    const pr::Flock_snapshot& snapshot = simulation.snapshot();
+
+    CHECK(snapshot.previous_boids.size() == snapshot.boids.size());
+    CHECK(!(snapshot.previous_boids.boid(0) == snapshot.boids.boid(0)));
+
+    const auto now = std::chrono::steady_clock::now();
+    CHECK(simulation.interpolation(snapshot.published) == 0.f);
+    CHECK(simulation.interpolation(now) >= 0.f);
+    CHECK(simulation.interpolation(now + std::chrono::seconds{1}) == 1.f);
+  }
+
+  SUBCASE("The flock stops at the last step:") {
+    pr::Flock stopping{100.f, 30.f, 0.05f, 0.5f, 0.0005f};
+    stopping.push_back(pr::Boid{pr::Vector2{100.f, 100.f},
+                                pr::Vector2{1.f, 2.f}, 10.f, 150.f});
+
+    pr::Simulation_thread limited{std::move(stopping), 800, 600, 0.001, 5,
+                                  50};
+    limited.set_real_time(false);
+
+    REQUIRE(wait_for(limited, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.step == 50;
+    }));
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    CHECK(limited.refresh() == false);
+    CHECK(limited.snapshot().step == 50);
+  }
+
+  SUBCASE("Out of real time the ticks don't wait:") {
+    simulation.set_real_time(false);
+
+    // 10000 ticks of a millisecond are ten seconds of simulated time.
+    CHECK(wait_for(simulation, [](const pr::Flock_snapshot& snapshot) {
+      return snapshot.step >= 10000;
+    }));
+  }
+}
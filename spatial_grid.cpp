@@ -0,0 +1,275 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace pr {
+namespace {
+// moves the i-th bit of "value" to the (2 * i)-th one.
+std::uint32_t spread_bits(std::uint16_t value) {
+  std::uint32_t bits = value;
+  bits = (bits | (bits << 8)) & 0x00ff00ffu;
+  bits = (bits | (bits << 4)) & 0x0f0f0f0fu;
+  bits = (bits | (bits << 2)) & 0x33333333u;
+  bits = (bits | (bits << 1)) & 0x55555555u;
+
+  return bits;
+}
+}  // namespace
+
+std::uint32_t morton_code(std::uint16_t x, std::uint16_t y) {
+  return spread_bits(x) | (spread_bits(y) << 1);
+}
+
+Spatial_grid::Spatial_grid(float cell_size)
+    : cell_size_{cell_size},
+      moved_first_(16, no_boid),
+      moved_{0},
+      x_min_{0},
+      x_max_{0},
+      y_min_{0},
+      y_max_{0},
+      dense_{false} {
+  assert(cell_size_ > 0.f);
+}
+
+float Spatial_grid::cell_size() const { return cell_size_; }
+
+std::size_t Spatial_grid::size() const { return cell_of_.size(); }
+
+int Spatial_grid::cell_coordinate(float coordinate) const {
+  const float cell = std::floor(coordinate / cell_size_);
+  const float limit = 1.e9f;  // keeps the conversion to int well defined.
+
+  return static_cast<int>(std::clamp(cell, -limit, limit));
+}
+
+std::size_t Spatial_grid::bucket_of(int cell_x, int cell_y) const {
+  if (dense_) {
+    const std::size_t rows = static_cast<std::size_t>(y_max_ - y_min_) + 1;
+
+    return static_cast<std::size_t>(cell_x - x_min_) * rows +
+           static_cast<std::size_t>(cell_y - y_min_);
+  }
+
+  const std::uint32_t hash = static_cast<std::uint32_t>(cell_x) * 73856093u ^
+                             static_cast<std::uint32_t>(cell_y) * 19349663u;
+
+  return hash & (bucket_start_.size() - 2);
+}
+
+bool Spatial_grid::has_bucket(int cell_x, int cell_y) const {
+  if (dense_) {
+    return cell_x >= x_min_ && cell_x <= x_max_ && cell_y >= y_min_ &&
+           cell_y <= y_max_;
+  }
+
+  // no buckets before the first rebuild.
+  return !bucket_start_.empty();
+}
+
+std::size_t Spatial_grid::moved_list_of(int cell_x, int cell_y) const {
+  const std::uint32_t hash = static_cast<std::uint32_t>(cell_x) * 73856093u ^
+                             static_cast<std::uint32_t>(cell_y) * 19349663u;
+
+  return hash & (moved_first_.size() - 1);
+}
+
+std::size_t Spatial_grid::moved_list_of(std::int64_t key) const {
+  const std::uint64_t bits = static_cast<std::uint64_t>(key);
+  const int cell_x = static_cast<int>(static_cast<std::uint32_t>(bits >> 32));
+  const int cell_y = static_cast<int>(static_cast<std::uint32_t>(bits));
+
+  return moved_list_of(cell_x, cell_y);
+}
+
+std::int64_t Spatial_grid::cell_key(int cell_x, int cell_y) {
+  return static_cast<std::int64_t>(
+      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_x)) << 32) |
+      static_cast<std::uint32_t>(cell_y));
+}
+
+std::int64_t Spatial_grid::cell_key(const Vector2& position) const {
+  return cell_key(cell_coordinate(position.x_axis()),
+                  cell_coordinate(position.y_axis()));
+}
+
+std::size_t Spatial_grid::bucket_of(std::int64_t key) const {
+  const std::uint64_t bits = static_cast<std::uint64_t>(key);
+  const int cell_x = static_cast<int>(static_cast<std::uint32_t>(bits >> 32));
+  const int cell_y = static_cast<int>(static_cast<std::uint32_t>(bits));
+
+  return bucket_of(cell_x, cell_y);
+}
+
+void Spatial_grid::prepare(std::size_t number_of_boids) {
+  // every list of moved boids starts from one of them: emptying their heads
+  // empties all of them, without going through the whole table.
+  for (std::size_t i{0}; i < cell_of_.size(); ++i) {
+    if (is_displaced_[i] == 1) {
+      moved_first_[moved_list_of(cell_of_[i])] = no_boid;
+    }
+  }
+  moved_ = 0;
+
+  x_min_ = std::numeric_limits<int>::max();
+  x_max_ = std::numeric_limits<int>::min();
+  y_min_ = std::numeric_limits<int>::max();
+  y_max_ = std::numeric_limits<int>::min();
+
+  // the most buckets finish() can ask for, so that the table doesn't
+  // allocate while the flock moves.
+  std::size_t buckets{16};
+  while (buckets < 2 * number_of_boids) {
+    buckets *= 2;
+  }
+  bucket_start_.reserve(buckets + 1);
+  bucket_cursor_.reserve(buckets);
+
+  // the table is empty, so it can grow with a new hash.
+  if (moved_first_.size() < buckets) {
+    moved_first_.resize(buckets, no_boid);
+  }
+
+  cell_of_.resize(number_of_boids);
+  is_displaced_.assign(number_of_boids, 0);
+  // only read for the displaced boids.
+  moved_next_.resize(number_of_boids);
+  moved_previous_.resize(number_of_boids);
+}
+
+void Spatial_grid::insert(std::size_t index, const Vector2& position) {
+  const int cell_x = cell_coordinate(position.x_axis());
+  const int cell_y = cell_coordinate(position.y_axis());
+
+  cell_of_[index] = cell_key(cell_x, cell_y);
+  x_min_ = std::min(x_min_, cell_x);
+  x_max_ = std::max(x_max_, cell_x);
+  y_min_ = std::min(y_min_, cell_y);
+  y_max_ = std::max(y_max_, cell_y);
+}
+
+void Spatial_grid::finish() {
+  // a flock which fills its range of cells gets a bucket for every cell,
+  // with no collisions and with the columns of the queries next to each
+  // other; a sparse one hashes its cells to about two buckets per boid.
+  std::uint64_t cells{0};
+  if (!cell_of_.empty()) {
+    const std::int64_t columns = static_cast<std::int64_t>(x_max_) - x_min_ + 1;
+    const std::int64_t rows = static_cast<std::int64_t>(y_max_) - y_min_ + 1;
+    cells = static_cast<std::uint64_t>(columns) *
+            static_cast<std::uint64_t>(rows);
+  }
+  dense_ = !cell_of_.empty() && cells <= 2 * cell_of_.size();
+
+  std::size_t buckets{16};
+  if (dense_) {
+    buckets = static_cast<std::size_t>(cells);
+  } else {
+    while (buckets < 2 * cell_of_.size()) {
+      buckets *= 2;
+    }
+  }
+
+  // one more element than the number of buckets, so that the boids of the
+  // bucket "b" are always entries_[bucket_start_[b]; bucket_start_[b + 1]).
+  bucket_start_.assign(buckets + 1, 0);
+  for (const std::int64_t key : cell_of_) {
+    ++bucket_start_[bucket_of(key) + 1];
+  }
+
+  for (std::size_t b{1}; b < bucket_start_.size(); ++b) {
+    bucket_start_[b] += bucket_start_[b - 1];
+  }
+
+  bucket_cursor_.assign(bucket_start_.begin(), bucket_start_.end() - 1);
+  entries_.resize(cell_of_.size());
+
+  for (std::size_t i{0}; i < cell_of_.size(); ++i) {
+    entries_[bucket_cursor_[bucket_of(cell_of_[i])]++] = i;
+  }
+  assert(bucket_start_.back() == entries_.size());
+}
+
+void Spatial_grid::link(std::size_t index) {
+  assert(is_displaced_[index] == 0);
+  const std::size_t list = moved_list_of(cell_of_[index]);
+
+  moved_previous_[index] = no_boid;
+  moved_next_[index] = moved_first_[list];
+  if (moved_first_[list] != no_boid) {
+    moved_previous_[moved_first_[list]] = index;
+  }
+  moved_first_[list] = index;
+
+  is_displaced_[index] = 1;
+  ++moved_;
+}
+
+void Spatial_grid::unlink(std::size_t index) {
+  assert(is_displaced_[index] == 1);
+  const std::size_t previous = moved_previous_[index];
+  const std::size_t next = moved_next_[index];
+
+  if (previous == no_boid) {
+    moved_first_[moved_list_of(cell_of_[index])] = next;
+  } else {
+    moved_next_[previous] = next;
+  }
+  if (next != no_boid) {
+    moved_previous_[next] = previous;
+  }
+
+  is_displaced_[index] = 0;
+  --moved_;
+}
+
+void Spatial_grid::move(std::size_t index, std::int64_t key) {
+  if (is_displaced_[index] == 1) {
+    unlink(index);
+  }
+  cell_of_[index] = key;
+  link(index);
+}
+
+void Spatial_grid::push_back(const Vector2& position) {
+  cell_of_.push_back(cell_key(position));
+  is_displaced_.push_back(0);
+  moved_next_.push_back(no_boid);
+  moved_previous_.push_back(no_boid);
+  link(cell_of_.size() - 1);
+}
+
+void Spatial_grid::relocate(std::size_t index, const Vector2& new_position) {
+  assert(index < cell_of_.size());
+
+  // a boid which left the cell it was indexed in goes to the list of its
+  // new cell, and from one list to the other if it moves again.
+  const std::int64_t key = cell_key(new_position);
+  if (cell_of_[index] != key) {
+    move(index, key);
+  }
+}
+
+void Spatial_grid::swap_and_pop(std::size_t index) {
+  assert(index < cell_of_.size());
+  const std::size_t last = cell_of_.size() - 1;
+
+  if (is_displaced_[last] == 1) {
+    unlink(last);
+  }
+
+  // the entry of the removed boid is left behind, so the moved one is
+  // listed in its cell.
+  if (index != last) {
+    move(index, cell_of_[last]);
+  }
+
+  cell_of_.pop_back();
+  is_displaced_.pop_back();
+  moved_next_.pop_back();
+  moved_previous_.pop_back();
+}
+}  // namespace pr
@@ -0,0 +1,154 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "vector2.hpp"
+
+namespace pr {
+// the position of the cell (x, y) along the Morton (Z-order) curve: the
+// bits of x and y interleaved, so that close cells tend to get close codes.
+std::uint32_t morton_code(std::uint16_t x, std::uint16_t y);
+
+class Spatial_grid {
+  float cell_size_;
+
+  std::vector<std::size_t> bucket_start_;
+
+  std::vector<std::size_t> bucket_cursor_;
+
+  std::vector<std::size_t> entries_;
+
+  std::vector<std::int64_t> cell_of_;
+
+  std::vector<unsigned char> is_displaced_;
+
+  // the boids which left the cell they were indexed in since the rebuild
+  // are kept in lists of their new cells, hashed to moved_first_ and linked
+  // through moved_next_ and moved_previous_: a boid is moved in O(1), and a
+  // query only visits the ones of its own cells.
+  static constexpr std::size_t no_boid = static_cast<std::size_t>(-1);
+
+  std::vector<std::size_t> moved_first_;
+
+  std::vector<std::size_t> moved_next_;
+
+  std::vector<std::size_t> moved_previous_;
+
+  std::size_t moved_;  // the number of displaced boids.
+
+  int x_min_;  // the range of the cells of the boids of the last rebuild.
+
+  int x_max_;
+
+  int y_min_;
+
+  int y_max_;
+
+  bool dense_;  // true: a bucket for every cell of the range, column by
+                // column. false: the cells are hashed to the buckets.
+
+  int cell_coordinate(float coordinate) const;
+
+  std::size_t bucket_of(int cell_x, int cell_y) const;
+
+  bool has_bucket(int cell_x, int cell_y) const;
+
+  std::size_t moved_list_of(int cell_x, int cell_y) const;
+
+  std::size_t moved_list_of(std::int64_t key) const;
+
+  static std::int64_t cell_key(int cell_x, int cell_y);
+
+  std::int64_t cell_key(const Vector2& position) const;
+
+  std::size_t bucket_of(std::int64_t key) const;
+
+  void prepare(std::size_t number_of_boids);
+
+  void insert(std::size_t index, const Vector2& position);
+
+  void finish();
+
+  // puts the boid in the list of the cell cell_of_[index].
+  void link(std::size_t index);
+
+  void unlink(std::size_t index);
+
+  void move(std::size_t index, std::int64_t key);
+
+ public:
+  explicit Spatial_grid(float cell_size);
+
+  float cell_size() const;
+
+  std::size_t size() const;
+
+  // rebuilds the index from scratch: "position_of(i)" has to return the
+  // position of the i-th boid, for every i in [0, number_of_boids).
+  template <typename Position_of>
+  void rebuild(std::size_t number_of_boids, Position_of position_of) {
+    prepare(number_of_boids);
+
+    for (std::size_t i{0}; i < number_of_boids; ++i) {
+      insert(i, position_of(i));
+    }
+
+    finish();
+  }
+
+  void push_back(const Vector2& position);
+
+  void relocate(std::size_t index, const Vector2& new_position);
+
+  // forgets the boid at "index", after the last boid was moved there (the
+  // swap-and-pop of the storage): until the next rebuild the moved boid is
+  // displaced.
+  void swap_and_pop(std::size_t index);
+
+  // calls "function(i)" once for every boid which could be closer than
+  // "radius" to "position": the caller still has to check the real distance.
+  template <typename Function>
+  void for_each_candidate(const Vector2& position, float radius,
+                          Function&& function) const {
+    const int x_min = cell_coordinate(position.x_axis() - radius);
+    const int x_max = cell_coordinate(position.x_axis() + radius);
+    const int y_min = cell_coordinate(position.y_axis() - radius);
+    const int y_max = cell_coordinate(position.y_axis() + radius);
+
+    for (int cell_x{x_min}; cell_x <= x_max; ++cell_x) {
+      for (int cell_y{y_min}; cell_y <= y_max; ++cell_y) {
+        const std::int64_t key = cell_key(cell_x, cell_y);
+
+        if (has_bucket(cell_x, cell_y)) {
+          const std::size_t bucket = bucket_of(cell_x, cell_y);
+
+          for (std::size_t k{bucket_start_[bucket]};
+               k < bucket_start_[bucket + 1]; ++k) {
+            const std::size_t index = entries_[k];
+
+            // the entries of the boids removed or moved since the rebuild
+            // are left behind.
+            if (index < cell_of_.size() && cell_of_[index] == key &&
+                is_displaced_[index] == 0) {
+              function(index);
+            }
+          }
+        }
+
+        if (moved_ != 0) {
+          for (std::size_t index = moved_first_[moved_list_of(cell_x, cell_y)];
+               index != no_boid; index = moved_next_[index]) {
+            if (cell_of_[index] == key) {
+              function(index);
+            }
+          }
+        }
+      }
+    }
+  }
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,251 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the for_each_candidate() method") {
+  const std::vector<pr::Vector2> positions{
+      {50.f, 40.f},   {100.f, 60.f},   {70.f, 90.f},  {130.f, 100.f},
+      {-30.f, -45.f}, {450.f, 460.f},  {99.f, 1.f},   {101.f, 199.f},
+      {249.f, 50.f},  {-150.f, 160.f}, {55.f, 46.f}, {10000.f, 10000.f}};
+
+  pr::Spatial_grid grid{100.f};
+  grid.rebuild(positions.size(),
+               [&positions](std::size_t i) { return positions[i]; });
+
+  CHECK(grid.size() == 12);
+
+  SUBCASE("Every boid closer than the radius is visited once:") {
+    for (const pr::Vector2& centre : positions) {
+      std::vector<std::size_t> visited;
+      grid.for_each_candidate(centre, 100.f, [&visited](std::size_t i) {
+        visited.push_back(i);
+      });
+
+      std::sort(visited.begin(), visited.end());
+      CHECK(std::adjacent_find(visited.begin(), visited.end()) ==
+            visited.end());
+
+      for (std::size_t i{0}; i < positions.size(); ++i) {
+        if (centre.distance(positions[i]) < 100.f) {
+          CHECK(std::binary_search(visited.begin(), visited.end(), i) == true);
+        }
+      }
+    }
+  }
+
+  SUBCASE("Far boids are not visited:") {
+    std::vector<std::size_t> visited;
+    grid.for_each_candidate(pr::Vector2{50.f, 40.f}, 100.f,
+                            [&visited](std::size_t i) { visited.push_back(i); });
+
+    CHECK(std::find(visited.begin(), visited.end(), 5) == visited.end());
+    CHECK(std::find(visited.begin(), visited.end(), 11) == visited.end());
+  }
+
+  SUBCASE("Radius larger than the cells:") {
+    std::size_t visited{0};
+    grid.for_each_candidate(pr::Vector2{50.f, 40.f}, 300.f,
+                            [&visited](std::size_t) { ++visited; });
+
+    CHECK(visited == 10);
+  }
+}
+
+TEST_CASE("Testing a grid whose boids fill their cells") {
+  // 200 boids in the 4x4 cells from (-200, -200) to (200, 200): a bucket
+  // for every cell.
+  std::vector<pr::Vector2> positions;
+  for (int i{0}; i < 200; ++i) {
+    const float x = static_cast<float>((i * 37) % 300) - 150.f;
+    const float y = static_cast<float>((i * 91) % 300) - 150.f;
+    positions.push_back(pr::Vector2{x, y});
+  }
+
+  pr::Spatial_grid grid{100.f};
+  grid.rebuild(positions.size(),
+               [&positions](std::size_t i) { return positions[i]; });
+
+  const auto visited_near = [&grid](const pr::Vector2& position,
+                                    float radius) {
+    std::vector<std::size_t> visited;
+    grid.for_each_candidate(position, radius, [&visited](std::size_t i) {
+      visited.push_back(i);
+    });
+    std::sort(visited.begin(), visited.end());
+
+    return visited;
+  };
+
+  SUBCASE("Every boid closer than the radius is visited once:") {
+    for (const pr::Vector2& centre :
+         {pr::Vector2{0.f, 0.f}, pr::Vector2{-140.f, 120.f},
+          pr::Vector2{170.f, -20.f}, pr::Vector2{-400.f, 0.f}}) {
+      const std::vector<std::size_t> visited = visited_near(centre, 60.f);
+
+      CHECK(std::adjacent_find(visited.begin(), visited.end()) ==
+            visited.end());
+      for (std::size_t i{0}; i < positions.size(); ++i) {
+        if (centre.distance(positions[i]) < 60.f) {
+          CHECK(std::binary_search(visited.begin(), visited.end(), i) == true);
+        }
+      }
+    }
+  }
+
+  SUBCASE("The queries out of the cells of the boids find nothing:") {
+    CHECK(visited_near(pr::Vector2{1000.f, 1000.f}, 100.f).empty() == true);
+  }
+
+  SUBCASE("A boid which left the cells of the boids is still found:") {
+    grid.relocate(0, pr::Vector2{1000.f, 1000.f});
+    grid.push_back(pr::Vector2{-1000.f, 1000.f});
+
+    CHECK(visited_near(pr::Vector2{1000.f, 1000.f}, 100.f) ==
+          std::vector<std::size_t>{0});
+    CHECK(visited_near(pr::Vector2{-1000.f, 1000.f}, 100.f) ==
+          std::vector<std::size_t>{200});
+  }
+}
+
+TEST_CASE("Testing the push_back() and relocate() methods") {
+  std::vector<pr::Vector2> positions{{50.f, 40.f}, {1000.f, 1000.f}};
+
+  pr::Spatial_grid grid{100.f};
+  grid.rebuild(positions.size(),
+               [&positions](std::size_t i) { return positions[i]; });
+
+  SUBCASE("Boid moved next to another one:") {
+    positions[1] = pr::Vector2{60.f, 50.f};
+    grid.relocate(1, positions[1]);
+
+    std::size_t visited{0};
+    grid.for_each_candidate(positions[0], 100.f,
+                            [&visited](std::size_t) { ++visited; });
+
+    CHECK(visited == 2);
+  }
+
+  SUBCASE("Boid added after the rebuild:") {
+    positions.push_back(pr::Vector2{70.f, 30.f});
+    grid.push_back(positions[2]);
+
+    std::vector<std::size_t> visited;
+    grid.for_each_candidate(positions[0], 100.f,
+                            [&visited](std::size_t i) { visited.push_back(i); });
+
+    CHECK(grid.size() == 3);
+    CHECK(visited.size() == 2);
+    CHECK(std::find(visited.begin(), visited.end(), 2) != visited.end());
+  }
+
+  SUBCASE("Boid moved twice is visited once:") {
+    grid.relocate(0, pr::Vector2{250.f, 40.f});
+    grid.relocate(0, pr::Vector2{450.f, 40.f});
+
+    std::size_t visited{0};
+    grid.for_each_candidate(pr::Vector2{450.f, 40.f}, 100.f,
+                            [&visited](std::size_t) { ++visited; });
+
+    CHECK(visited == 1);
+  }
+
+  SUBCASE("Moved boids are only visited near their new cells:") {
+    grid.relocate(1, pr::Vector2{1200.f, 1000.f});
+    grid.relocate(0, pr::Vector2{850.f, 1050.f});
+
+    std::vector<std::size_t> visited;
+    grid.for_each_candidate(pr::Vector2{50.f, 40.f}, 100.f,
+                            [&visited](std::size_t i) { visited.push_back(i); });
+    CHECK(visited.empty() == true);
+
+    grid.for_each_candidate(pr::Vector2{900.f, 1000.f}, 100.f,
+                            [&visited](std::size_t i) { visited.push_back(i); });
+    CHECK(visited == std::vector<std::size_t>{0});
+  }
+}
+
+TEST_CASE("Testing the swap_and_pop() method") {
+  std::vector<pr::Vector2> positions{
+      {50.f, 40.f}, {1000.f, 1000.f}, {60.f, 50.f}, {70.f, 30.f}};
+
+  pr::Spatial_grid grid{100.f};
+  grid.rebuild(positions.size(),
+               [&positions](std::size_t i) { return positions[i]; });
+
+  const auto visited_near = [&grid](const pr::Vector2& position) {
+    std::vector<std::size_t> visited;
+    grid.for_each_candidate(position, 100.f, [&visited](std::size_t i) {
+      visited.push_back(i);
+    });
+    std::sort(visited.begin(), visited.end());
+
+    return visited;
+  };
+
+  SUBCASE("The last boid takes the place of the removed one:") {
+    // the boid 3 (70, 30) goes to the index 1.
+    grid.swap_and_pop(1);
+
+    CHECK(grid.size() == 3);
+    CHECK(visited_near(positions[0]) == std::vector<std::size_t>{0, 1, 2});
+  }
+
+  SUBCASE("The last boid is removed:") {
+    grid.swap_and_pop(3);
+
+    CHECK(grid.size() == 3);
+    CHECK(visited_near(positions[0]) == std::vector<std::size_t>{0, 2});
+  }
+
+  SUBCASE("A removed index can be given to a new boid:") {
+    grid.swap_and_pop(3);
+    grid.swap_and_pop(2);
+    grid.push_back(pr::Vector2{2000.f, 2000.f});
+
+    CHECK(grid.size() == 3);
+    CHECK(visited_near(positions[0]) == std::vector<std::size_t>{0});
+    CHECK(visited_near(pr::Vector2{2000.f, 2000.f}) ==
+          std::vector<std::size_t>{2});
+  }
+
+  SUBCASE("Displaced boids removed in any order are forgotten:") {
+    // the boids 4, 5 and 6 are displaced, in this order.
+    grid.push_back(pr::Vector2{55.f, 45.f});
+    grid.push_back(pr::Vector2{3000.f, 3000.f});
+    grid.push_back(pr::Vector2{65.f, 35.f});
+
+    // the boid 6 (65, 35) goes to the index 4, the boid 5 to the index 0.
+    grid.swap_and_pop(4);
+    grid.swap_and_pop(0);
+
+    CHECK(grid.size() == 5);
+    CHECK(visited_near(positions[2]) == std::vector<std::size_t>{2, 3, 4});
+    CHECK(visited_near(pr::Vector2{3000.f, 3000.f}) ==
+          std::vector<std::size_t>{0});
+
+    // (65, 35) goes to the index 3 and then back to the index 0, where it
+    // is visited only once.
+    grid.swap_and_pop(3);
+    grid.swap_and_pop(0);
+
+    CHECK(grid.size() == 3);
+    CHECK(visited_near(positions[2]) == std::vector<std::size_t>{0, 2});
+  }
+}
+
+TEST_CASE("Testing the morton_code() function") {
+  CHECK(pr::morton_code(0, 0) == 0u);
+  CHECK(pr::morton_code(1, 0) == 1u);
+  CHECK(pr::morton_code(0, 1) == 2u);
+  CHECK(pr::morton_code(3, 3) == 15u);
+  CHECK(pr::morton_code(4, 0) == 16u);
+  CHECK(pr::morton_code(0xffff, 0) == 0x55555555u);
+  CHECK(pr::morton_code(0xffff, 0xffff) == 0xffffffffu);
+
+  // the four cells of a 2x2 square come before the ones beside it.
+  CHECK(pr::morton_code(1, 1) < pr::morton_code(2, 0));
+}
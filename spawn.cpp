@@ -0,0 +1,75 @@
+#define _USE_MATH_DEFINES
+#include "spawn.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace pr {
+Spawn_area::Spawn_area(Spawn_shape shape, const Vector2& centre,
+                       const Vector2& size)
+    : shape_{shape}, centre_{centre}, size_{size} {}
+
+Spawn_area Spawn_area::box(const Vector2& minimum, const Vector2& maximum) {
+  assert(minimum.x_axis() <= maximum.x_axis() &&
+         minimum.y_axis() <= maximum.y_axis());
+
+  return Spawn_area{Spawn_shape::box, (minimum + maximum) * 0.5f,
+                    (maximum - minimum) * 0.5f};
+}
+
+Spawn_area Spawn_area::gaussian(const Vector2& centre, float deviation) {
+  assert(deviation >= 0.f);
+
+  return Spawn_area{Spawn_shape::gaussian, centre,
+                    Vector2{deviation, deviation}};
+}
+
+Spawn_area Spawn_area::ring(const Vector2& centre, float inner_radius,
+                            float outer_radius) {
+  assert(inner_radius >= 0.f && inner_radius <= outer_radius);
+
+  return Spawn_area{Spawn_shape::ring, centre,
+                    Vector2{inner_radius, outer_radius}};
+}
+
+Spawn_shape Spawn_area::shape() const { return shape_; }
+
+Vector2 Spawn_area::centre() const { return centre_; }
+
+Vector2 Spawn_area::size() const { return size_; }
+
+Vector2 Spawn_area::operator()(std::mt19937& engine) const {
+  switch (shape_) {
+    case Spawn_shape::box: {
+      std::uniform_real_distribution<float> unit{-1.f, 1.f};
+      const float x = unit(engine);
+      const float y = unit(engine);
+
+      return centre_ + Vector2{x * size_.x_axis(), y * size_.y_axis()};
+    }
+
+    case Spawn_shape::gaussian: {
+      std::normal_distribution<float> normal;
+      const float x = normal(engine);
+      const float y = normal(engine);
+
+      return centre_ + Vector2{x * size_.x_axis(), y * size_.y_axis()};
+    }
+
+    default: {
+      // uniform in the area: the square of the radius is uniform.
+      const float inner = size_.x_axis();
+      const float outer = size_.y_axis();
+      std::uniform_real_distribution<float> squared_radius{inner * inner,
+                                                           outer * outer};
+      std::uniform_real_distribution<float> angle{0.f,
+                                                  static_cast<float>(2. * M_PI)};
+      const float radius = std::sqrt(squared_radius(engine));
+      const float theta = angle(engine);
+
+      return centre_ +
+             Vector2{radius * std::cos(theta), radius * std::sin(theta)};
+    }
+  }
+}
+}  // namespace pr
@@ -0,0 +1,63 @@
+#ifndef SPAWN_HPP
+#define SPAWN_HPP
+
+#include <cstddef>
+#include <random>
+
+#include "species.hpp"
+#include "vector2.hpp"
+
+namespace pr {
+enum class Spawn_shape { box, gaussian, ring };
+
+// where Flock::spawn() puts the new boids: a distribution of positions.
+class Spawn_area {
+  Spawn_shape shape_;
+
+  Vector2 centre_;  // of the box too.
+
+  Vector2 size_;  // box: the half sides; gaussian: the standard deviations
+                  // along x and y; ring: the inner and the outer radius.
+
+  Spawn_area(Spawn_shape shape, const Vector2& centre, const Vector2& size);
+
+ public:
+  // uniform in the box with opposite corners "minimum" and "maximum".
+  static Spawn_area box(const Vector2& minimum, const Vector2& maximum);
+
+  static Spawn_area gaussian(const Vector2& centre, float deviation);
+
+  // uniform in the area between the two circles.
+  static Spawn_area ring(const Vector2& centre, float inner_radius,
+                         float outer_radius);
+
+  Spawn_shape shape() const;
+
+  Vector2 centre() const;
+
+  Vector2 size() const;
+
+  Vector2 operator()(std::mt19937& engine) const;
+};
+
+// "count" boids of "species" in "area", whose velocity components are normal
+// with mean 0 (like the boids clicked in the window), and whose view angle
+// is uniform in [min_view_angle, max_view_angle].
+struct Spawn_spec {
+  Spawn_area area;
+
+  std::size_t count;
+
+  Species species;
+
+  float velocity_deviation;
+
+  float maximum_velocity;
+
+  float min_view_angle;
+
+  float max_view_angle;
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,71 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "spawn.hpp"
+
+#include <random>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the box spawn area") {
+  const pr::Spawn_area area =
+      pr::Spawn_area::box(pr::Vector2{-10.f, 20.f}, pr::Vector2{30.f, 60.f});
+  std::mt19937 engine{42};
+
+  CHECK(area.shape() == pr::Spawn_shape::box);
+  CHECK(area.centre() == pr::Vector2{10.f, 40.f});
+  CHECK(area.size() == pr::Vector2{20.f, 20.f});
+
+  pr::Vector2 sum{};
+  bool inside{true};
+  for (int i{0}; i < 10000; ++i) {
+    const pr::Vector2 position = area(engine);
+
+    inside = inside && position.x_axis() >= -10.f &&
+             position.x_axis() <= 30.f && position.y_axis() >= 20.f &&
+             position.y_axis() <= 60.f;
+    sum += position;
+  }
+
+  CHECK(inside == true);
+  CHECK(sum.x_axis() / 10000.f == doctest::Approx(10.0).epsilon(0.05));
+  CHECK(sum.y_axis() / 10000.f == doctest::Approx(40.0).epsilon(0.05));
+}
+
+TEST_CASE("Testing the gaussian spawn area") {
+  const pr::Spawn_area area =
+      pr::Spawn_area::gaussian(pr::Vector2{100.f, -50.f}, 5.f);
+  std::mt19937 engine{42};
+
+  pr::Vector2 sum{};
+  float squared_sum{0.f};
+  for (int i{0}; i < 10000; ++i) {
+    const pr::Vector2 position = area(engine);
+
+    sum += position;
+    squared_sum += position.squared_distance(pr::Vector2{100.f, -50.f});
+  }
+
+  CHECK(sum.x_axis() / 10000.f == doctest::Approx(100.0).epsilon(0.01));
+  CHECK(sum.y_axis() / 10000.f == doctest::Approx(-50.0).epsilon(0.01));
+  // the variances along x and y add up.
+  CHECK(squared_sum / 10000.f == doctest::Approx(50.0).epsilon(0.05));
+}
+
+TEST_CASE("Testing the ring spawn area") {
+  const pr::Spawn_area area =
+      pr::Spawn_area::ring(pr::Vector2{0.f, 0.f}, 100.f, 200.f);
+  std::mt19937 engine{42};
+
+  bool inside{true};
+  int outer_half{0};
+  for (int i{0}; i < 10000; ++i) {
+    const float radius = area(engine).lenght_of_vector();
+
+    inside = inside && radius >= 99.99f && radius <= 200.01f;
+    outer_half += radius >= 150.f ? 1 : 0;
+  }
+
+  CHECK(inside == true);
+  // uniform in the area: (200^2 - 150^2) / (200^2 - 100^2) of the boids are
+  // beyond 150.
+  CHECK(outer_half / 10000.f == doctest::Approx(17.5 / 30.).epsilon(0.05));
+}
@@ -0,0 +1,75 @@
+#include "species.hpp"
+
+#include <cassert>
+
+namespace pr {
+Interaction default_interaction(Species chosen, Species other) {
+  if (chosen == Species::prey) {
+    const bool same_species = other == Species::prey;
+
+    return {same_species, same_species, true, other == Species::predator};
+
+  } else if (chosen == Species::predator) {
+    return {other == Species::prey, false, false, false};
+
+  } else {
+    return {false, false, false, false};
+  }
+}
+
+Interaction_table::Interaction_table(std::size_t species_count)
+    : species_count_{species_count},
+      interactions_(species_count * species_count,
+                    Interaction{false, false, false, false}),
+      flees_(species_count, 0) {
+  assert(species_count_ >= 1 && species_count_ <= 256);
+}
+
+Interaction_table Interaction_table::prey_and_predators() {
+  Interaction_table table{2};
+
+  for (const Species chosen : {Species::prey, Species::predator}) {
+    for (const Species other : {Species::prey, Species::predator}) {
+      table.set(chosen, other, default_interaction(chosen, other));
+    }
+  }
+
+  return table;
+}
+
+std::size_t Interaction_table::species_count() const { return species_count_; }
+
+bool Interaction_table::contains(Species species) const {
+  return static_cast<std::size_t>(species) < species_count_;
+}
+
+const Interaction& Interaction_table::operator()(Species chosen,
+                                                 Species other) const {
+  assert(contains(chosen) && contains(other));
+
+  return interactions_[static_cast<std::size_t>(chosen) * species_count_ +
+                       static_cast<std::size_t>(other)];
+}
+
+void Interaction_table::set(Species chosen, Species other,
+                            const Interaction& interaction) {
+  assert(contains(chosen) && contains(other));
+
+  const std::size_t row = static_cast<std::size_t>(chosen);
+  interactions_[row * species_count_ + static_cast<std::size_t>(other)] =
+      interaction;
+
+  flees_[row] = 0;
+  for (std::size_t column{0}; column < species_count_; ++column) {
+    if (interactions_[row * species_count_ + column].flight) {
+      flees_[row] = 1;
+    }
+  }
+}
+
+bool Interaction_table::flees_any(Species chosen) const {
+  assert(contains(chosen));
+
+  return flees_[static_cast<std::size_t>(chosen)] == 1;
+}
+}  // namespace pr
@@ -0,0 +1,58 @@
+#ifndef SPECIES_HPP
+#define SPECIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pr {
+// the species of a boid is a small id: prey and predator are the two of the
+// original simulation, but a flock can have up to 256 of them, which react
+// to each other as its Interaction_table says.
+enum class Species : std::uint8_t { prey, predator };
+
+// how a boid of one species reacts to a near boid of another one (or of its
+// own).
+struct Interaction {
+  bool cohesion;  // moves towards it, if it can see it.
+
+  bool allignment;  // matches its velocity, if it can see it.
+
+  bool separation;  // keeps its distance from it.
+
+  bool flight;  // is chased by it: a chased boid goes through the border of
+                // the window instead of bouncing on it.
+};
+
+// prey flock together, keep their distance from everything and flee the
+// predators, while predators only chase the prey. Any other species ignores
+// and is ignored.
+Interaction default_interaction(Species chosen, Species other);
+
+class Interaction_table {
+  std::size_t species_count_;
+
+  std::vector<Interaction> interactions_;  // row "chosen", column "other".
+
+  std::vector<unsigned char> flees_;  // whether a species flees any other.
+
+ public:
+  // every species ignores every other one.
+  explicit Interaction_table(std::size_t species_count);
+
+  // the default_interaction() of prey and predators.
+  static Interaction_table prey_and_predators();
+
+  std::size_t species_count() const;
+
+  bool contains(Species species) const;
+
+  const Interaction& operator()(Species chosen, Species other) const;
+
+  void set(Species chosen, Species other, const Interaction& interaction);
+
+  bool flees_any(Species chosen) const;
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,53 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "species.hpp"
+
+#include "doctest.h"
+
+TEST_CASE("Testing the default_interaction() function") {
+  const pr::Interaction prey_prey =
+      pr::default_interaction(pr::Species::prey, pr::Species::prey);
+  const pr::Interaction prey_predator =
+      pr::default_interaction(pr::Species::prey, pr::Species::predator);
+  const pr::Interaction predator_prey =
+      pr::default_interaction(pr::Species::predator, pr::Species::prey);
+  const pr::Interaction predator_predator =
+      pr::default_interaction(pr::Species::predator, pr::Species::predator);
+
+  CHECK((prey_prey.cohesion && prey_prey.allignment && prey_prey.separation &&
+         !prey_prey.flight) == true);
+  CHECK((!prey_predator.cohesion && !prey_predator.allignment &&
+         prey_predator.separation && prey_predator.flight) == true);
+  CHECK((predator_prey.cohesion && !predator_prey.allignment &&
+         !predator_prey.separation && !predator_prey.flight) == true);
+  CHECK((!predator_predator.cohesion && !predator_predator.allignment &&
+         !predator_predator.separation && !predator_predator.flight) == true);
+}
+
+TEST_CASE("Testing the Interaction_table class") {
+  SUBCASE("Prey and predators:") {
+    const pr::Interaction_table table =
+        pr::Interaction_table::prey_and_predators();
+
+    CHECK(table.species_count() == 2);
+    CHECK(table.contains(pr::Species::predator) == true);
+    CHECK(table.contains(static_cast<pr::Species>(2)) == false);
+    CHECK(table(pr::Species::prey, pr::Species::predator).flight == true);
+    CHECK(table.flees_any(pr::Species::prey) == true);
+    CHECK(table.flees_any(pr::Species::predator) == false);
+  }
+
+  SUBCASE("Three species:") {
+    const pr::Species gull = static_cast<pr::Species>(2);
+    pr::Interaction_table table{3};
+
+    CHECK(table(gull, gull).cohesion == false);
+    CHECK(table.flees_any(gull) == false);
+
+    table.set(gull, pr::Species::predator, {false, false, true, true});
+    CHECK(table(gull, pr::Species::predator).separation == true);
+    CHECK(table.flees_any(gull) == true);
+
+    table.set(gull, pr::Species::predator, {false, false, true, false});
+    CHECK(table.flees_any(gull) == false);
+  }
+}
@@ -0,0 +1,84 @@
+#include "statistics.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace pr {
+Running_statistics::Running_statistics()
+    : count_{0}, mean_{0.}, quadratic_difference_{0.} {}
+
+void Running_statistics::add(double value) {
+  ++count_;
+
+  const double difference = value - mean_;
+  mean_ += difference / static_cast<double>(count_);
+  quadratic_difference_ += difference * (value - mean_);
+}
+
+std::size_t Running_statistics::count() const { return count_; }
+
+double Running_statistics::mean() const { return mean_; }
+
+double Running_statistics::quadratic_difference() const {
+  return quadratic_difference_;
+}
+
+double Running_statistics::error_of_mean(double population) const {
+  assert(count_ >= 2 && population >= static_cast<double>(count_));
+
+  const double variance =
+      quadratic_difference_ / static_cast<double>(count_ - 1);
+
+  return std::sqrt(variance / population);
+}
+
+Simulation_state state_of(const Boid_store& boids, Statistics_mode mode,
+                          std::size_t distance_samples, std::mt19937& engine) {
+  if (boids.size() > 2) {
+    const std::size_t number_of_boids = boids.size();
+    const double pairs = 0.5 * static_cast<double>(number_of_boids) *
+                         static_cast<double>(number_of_boids - 1);
+
+    Running_statistics velocities;
+    for (std::size_t i{0}; i < number_of_boids; ++i) {
+      velocities.add(boids.velocity(i).lenght_of_vector());
+    }
+
+    Running_statistics distances;
+    if (mode == Statistics_mode::exact ||
+        pairs <= static_cast<double>(distance_samples)) {
+      for (std::size_t j{0}; j < number_of_boids; ++j) {
+        for (std::size_t i{j + 1}; i < number_of_boids; ++i) {
+          distances.add(boids.position(j).distance(boids.position(i)));
+        }
+      }
+
+    } else {
+      // "i" is drawn among the boids other than "j", so that every pair of
+      // different boids is equally likely.
+      std::uniform_int_distribution<std::size_t> first{0, number_of_boids - 1};
+      std::uniform_int_distribution<std::size_t> second{0,
+                                                        number_of_boids - 2};
+
+      for (std::size_t sample{0}; sample < distance_samples; ++sample) {
+        const std::size_t j = first(engine);
+        std::size_t i = second(engine);
+        if (i >= j) {
+          ++i;
+        }
+
+        distances.add(boids.position(j).distance(boids.position(i)));
+      }
+    }
+
+    return {static_cast<float>(velocities.mean()),
+            static_cast<float>(velocities.error_of_mean(
+                static_cast<double>(number_of_boids))),
+            static_cast<float>(distances.mean()),
+            static_cast<float>(distances.error_of_mean(pairs))};
+
+  } else {
+    return {0.f, 0.f, 0.f, 0.f};
+  }
+}
+}  // namespace pr
@@ -0,0 +1,59 @@
+#ifndef STATISTICS_HPP
+#define STATISTICS_HPP
+
+#include <cstddef>
+#include <random>
+
+#include "boid_store.hpp"
+
+namespace pr {
+
+struct Simulation_state {
+  float medium_velocity;
+  float err_velocity;
+  float medium_distance;
+  float err_distance;
+};
+
+// exact: the mean distance among the boids is computed over every pair, in
+// O(N^2) time. sampled: it is estimated over a fixed number of random pairs,
+// in constant time, with a relative error which shrinks as one over the
+// square root of the number of pairs (flocks with fewer pairs than that are
+// computed exactly). The velocities are always computed exactly, in O(N).
+enum class Statistics_mode { exact, sampled };
+
+// mean and spread of a stream of values, updated one value at a time with
+// Welford's algorithm: nothing is stored, and the result doesn't suffer from
+// the cancellation of a sum of squares.
+class Running_statistics {
+  std::size_t count_;
+
+  double mean_;
+
+  double quadratic_difference_;  // sum of (value - mean)^2.
+
+ public:
+  Running_statistics();
+
+  void add(double value);
+
+  std::size_t count() const;
+
+  double mean() const;
+
+  double quadratic_difference() const;
+
+  // the spread of the values divided by the square root of "population", the
+  // number of values they stand for: with population == count() it is the
+  // error of the mean given by Flock::state(), while a sample of a larger
+  // population gives an estimate of the error of the whole population.
+  double error_of_mean(double population) const;
+};
+
+// mean and error of the speed of the boids and of the distance among them;
+// "engine" draws the pairs of the sampled mode.
+Simulation_state state_of(const Boid_store& boids, Statistics_mode mode,
+                          std::size_t distance_samples, std::mt19937& engine);
+}  // namespace pr
+
+#endif
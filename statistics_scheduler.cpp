@@ -0,0 +1,136 @@
+#include "statistics_scheduler.hpp"
+
+#include <cassert>
+
+namespace pr {
+Statistics_scheduler::Statistics_scheduler()
+    : every_updates_{0},
+      every_seconds_{0.},
+      updates_since_{0},
+      seconds_since_{0.},
+      mode_{Statistics_mode::exact},
+      distance_samples_{4096},
+      latest_{0.f, 0.f, 0.f, 0.f},
+      results_{0},
+      busy_{false},
+      stopping_{false} {}
+
+Statistics_scheduler::~Statistics_scheduler() { stop_worker(); }
+
+void Statistics_scheduler::set_cadence(std::size_t every_updates,
+                                       double every_seconds) {
+  assert(every_seconds >= 0.);
+
+  every_updates_ = every_updates;
+  every_seconds_ = every_seconds;
+  updates_since_ = 0;
+  seconds_since_ = 0.;
+}
+
+void Statistics_scheduler::set_mode(Statistics_mode mode,
+                                    std::size_t distance_samples) {
+  const std::lock_guard<std::mutex> lock{mutex_};
+  mode_ = mode;
+  distance_samples_ = distance_samples;
+}
+
+void Statistics_scheduler::set_background(bool background) {
+  if (background && !worker_.joinable()) {
+    stopping_ = false;
+    worker_ = std::thread{[this] { work(); }};
+
+  } else if (!background) {
+    stop_worker();
+  }
+}
+
+bool Statistics_scheduler::background() const { return worker_.joinable(); }
+
+void Statistics_scheduler::stop_worker() {
+  if (worker_.joinable()) {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+  }
+}
+
+void Statistics_scheduler::work() {
+  std::unique_lock<std::mutex> lock{mutex_};
+
+  for (;;) {
+    wake_.wait(lock, [this] { return busy_ || stopping_; });
+
+    // a computation handed over before stopping is finished anyway.
+    if (busy_) {
+      const Statistics_mode mode = mode_;
+      const std::size_t distance_samples = distance_samples_;
+      lock.unlock();
+
+      const Simulation_state state =
+          state_of(snapshot_, mode, distance_samples, engine_);
+
+      lock.lock();
+      latest_ = state;
+      ++results_;
+      busy_ = false;
+
+    } else {
+      return;
+    }
+  }
+}
+
+void Statistics_scheduler::on_update(const Boid_store& boids, double seconds) {
+  if (every_updates_ == 0 && every_seconds_ == 0.) {
+    return;
+  }
+
+  ++updates_since_;
+  seconds_since_ += seconds;
+
+  const bool due = (every_updates_ != 0 && updates_since_ >= every_updates_) ||
+                   (every_seconds_ != 0. && seconds_since_ >= every_seconds_);
+  if (!due) {
+    return;
+  }
+
+  if (worker_.joinable()) {
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      if (busy_) {
+        return;
+      }
+
+      // the worker is idle, so it doesn't read the snapshot while it is
+      // copied (the copy reuses the memory of the previous one).
+      snapshot_ = boids;
+      busy_ = true;
+    }
+    wake_.notify_one();
+
+  } else {
+    const Simulation_state state =
+        state_of(boids, mode_, distance_samples_, engine_);
+
+    const std::lock_guard<std::mutex> lock{mutex_};
+    latest_ = state;
+    ++results_;
+  }
+
+  updates_since_ = 0;
+  seconds_since_ = 0.;
+}
+
+Simulation_state Statistics_scheduler::latest() const {
+  const std::lock_guard<std::mutex> lock{mutex_};
+  return latest_;
+}
+
+std::size_t Statistics_scheduler::results() const {
+  const std::lock_guard<std::mutex> lock{mutex_};
+  return results_;
+}
+}  // namespace pr
@@ -0,0 +1,81 @@
+#ifndef STATISTICS_SCHEDULER_HPP
+#define STATISTICS_SCHEDULER_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "statistics.hpp"
+
+namespace pr {
+// decides when the statistics of a flock are computed, and keeps the latest
+// result: they are computed every "every_updates" updates and/or every
+// "every_seconds" seconds of simulated time (0 turns off either criterion).
+// In background mode they are computed by a worker thread on a copy of the
+// flock, so that an update never waits for them: an update which finds the
+// worker still busy leaves the computation to the following one.
+class Statistics_scheduler {
+  std::size_t every_updates_;
+
+  double every_seconds_;
+
+  std::size_t updates_since_;
+
+  double seconds_since_;
+
+  Statistics_mode mode_;
+
+  std::size_t distance_samples_;
+
+  std::mt19937 engine_;
+
+  Boid_store snapshot_;  // the copy of the flock read by the worker.
+
+  mutable std::mutex mutex_;  // guards everything below.
+
+  std::condition_variable wake_;
+
+  Simulation_state latest_;
+
+  std::size_t results_;
+
+  bool busy_;  // the worker owns snapshot_ and engine_.
+
+  bool stopping_;
+
+  std::thread worker_;
+
+  void work();
+
+  void stop_worker();
+
+ public:
+  Statistics_scheduler();
+
+  ~Statistics_scheduler();
+
+  Statistics_scheduler(const Statistics_scheduler&) = delete;
+
+  Statistics_scheduler& operator=(const Statistics_scheduler&) = delete;
+
+  void set_cadence(std::size_t every_updates, double every_seconds);
+
+  void set_mode(Statistics_mode mode, std::size_t distance_samples);
+
+  void set_background(bool background);
+
+  bool background() const;
+
+  // to be called after every update of the flock, which lasted "seconds".
+  void on_update(const Boid_store& boids, double seconds);
+
+  // the latest result (all zero before the first one) and the number of
+  // results so far; both can be read from any thread.
+  Simulation_state latest() const;
+
+  std::size_t results() const;
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "statistics_scheduler.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "doctest.h"
+
+namespace {
+pr::Boid_store three_boids() {
+  pr::Boid_store boids;
+  boids.push_back(pr::Boid{pr::Vector2{2.f, 3.f}, pr::Vector2{5.f, 6.f},
+                           1000.f, 180.f});
+  boids.push_back(pr::Boid{pr::Vector2{4.f, 5.f}, pr::Vector2{6.f, 7.f},
+                           1000.f, 180.f});
+  boids.push_back(pr::Boid{pr::Vector2{8.f, 9.f}, pr::Vector2{10.f, 11.f},
+                           1000.f, 180.f});
+
+  return boids;
+}
+
+bool wait_for_results(const pr::Statistics_scheduler& scheduler,
+                      std::size_t results) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+  while (scheduler.results() < results) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+}  // namespace
+
+TEST_CASE("Testing the cadence of the Statistics_scheduler") {
+  const pr::Boid_store boids = three_boids();
+  pr::Statistics_scheduler scheduler;
+
+  SUBCASE("No cadence, no statistics:") {
+    for (int update{0}; update < 10; ++update) {
+      scheduler.on_update(boids, 1.);
+    }
+
+    CHECK(scheduler.results() == 0);
+    CHECK(scheduler.latest().medium_velocity == 0.f);
+  }
+
+  SUBCASE("Every three updates:") {
+    scheduler.set_cadence(3, 0.);
+
+    scheduler.on_update(boids, 1.);
+    scheduler.on_update(boids, 1.);
+    CHECK(scheduler.results() == 0);
+
+    scheduler.on_update(boids, 1.);
+    CHECK(scheduler.results() == 1);
+    CHECK(scheduler.latest().medium_velocity ==
+          doctest::Approx(10.6319544).epsilon(0.0000001));
+    CHECK(scheduler.latest().medium_distance ==
+          doctest::Approx(5.6568542).epsilon(0.0000001));
+
+    for (int update{0}; update < 6; ++update) {
+      scheduler.on_update(boids, 1.);
+    }
+    CHECK(scheduler.results() == 3);
+  }
+
+  SUBCASE("Every half a second:") {
+    scheduler.set_cadence(0, 0.5);
+
+    for (int update{0}; update < 10; ++update) {
+      scheduler.on_update(boids, 0.125);
+    }
+    CHECK(scheduler.results() == 2);
+  }
+}
+
+TEST_CASE("Testing the background Statistics_scheduler") {
+  const pr::Boid_store boids = three_boids();
+  pr::Statistics_scheduler scheduler;
+  scheduler.set_cadence(1, 0.);
+  scheduler.set_background(true);
+
+  CHECK(scheduler.background() == true);
+
+  scheduler.on_update(boids, 1.);
+  REQUIRE(wait_for_results(scheduler, 1));
+  CHECK(scheduler.latest().medium_velocity ==
+        doctest::Approx(10.6319544).epsilon(0.0000001));
+  CHECK(scheduler.latest().err_distance ==
+        doctest::Approx(1.6329931).epsilon(0.0000001));
+
+  // the updates never wait: some of them may find the worker busy.
+  for (int update{0}; update < 100; ++update) {
+    scheduler.on_update(boids, 1.);
+  }
+  scheduler.set_background(false);
+
+  CHECK(scheduler.background() == false);
+  CHECK(scheduler.results() >= 2);
+  CHECK(scheduler.results() <= 101);
+}
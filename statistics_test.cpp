@@ -0,0 +1,40 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "statistics.hpp"
+
+#include <cmath>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the Running_statistics class") {
+  pr::Running_statistics statistics;
+
+  SUBCASE("Three values:") {
+    statistics.add(7.810249676);
+    statistics.add(9.219544457);
+    statistics.add(14.86606875);
+
+    CHECK(statistics.count() == 3);
+    CHECK(statistics.mean() == doctest::Approx(10.63195429));
+    CHECK(statistics.quadratic_difference() ==
+          doctest::Approx(27.88464373).epsilon(0.00000001));
+    CHECK(statistics.error_of_mean(3.) ==
+          doctest::Approx(std::sqrt(27.88464373 / 6.)));
+  }
+
+  SUBCASE("A large offset doesn't cancel the spread:") {
+    for (int i{0}; i < 1000; ++i) {
+      statistics.add(1.e9 + (i % 2 == 0 ? 1. : -1.));
+    }
+
+    CHECK(statistics.mean() == doctest::Approx(1.e9));
+    CHECK(statistics.quadratic_difference() == doctest::Approx(1000.));
+  }
+
+  SUBCASE("A sample of a larger population:") {
+    statistics.add(1.);
+    statistics.add(3.);
+
+    // the variance of the sample is 2.
+    CHECK(statistics.error_of_mean(200.) == doctest::Approx(0.1));
+  }
+}
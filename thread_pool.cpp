@@ -0,0 +1,111 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace pr {
+Thread_pool::Thread_pool(unsigned int thread_count)
+    : task_{nullptr},
+      call_{nullptr},
+      count_{0},
+      chunk_{1},
+      next_begin_{0},
+      generation_{0},
+      busy_workers_{0},
+      stopping_{false} {
+  assert(thread_count >= 1);
+
+  // the thread which calls parallel_for() works too.
+  workers_.reserve(thread_count - 1);
+  for (unsigned int i{1}; i < thread_count; ++i) {
+    workers_.emplace_back([this] { work(); });
+  }
+}
+
+Thread_pool::~Thread_pool() {
+  {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    stopping_ = true;
+  }
+  start_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+unsigned int Thread_pool::thread_count() const {
+  return static_cast<unsigned int>(workers_.size()) + 1;
+}
+
+void Thread_pool::run_chunks() {
+  for (;;) {
+    const std::size_t begin = next_begin_.fetch_add(chunk_);
+
+    if (begin >= count_) {
+      return;
+    }
+
+    call_(task_, begin, std::min(begin + chunk_, count_));
+  }
+}
+
+void Thread_pool::work() {
+  std::size_t seen_generation{0};
+
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      start_.wait(lock, [this, seen_generation] {
+        return stopping_ || generation_ != seen_generation;
+      });
+
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    run_chunks();
+
+    {
+      const std::lock_guard<std::mutex> lock{mutex_};
+      --busy_workers_;
+    }
+    done_.notify_one();
+  }
+}
+
+void Thread_pool::run(std::size_t count, const void* task,
+                      void (*call)(const void* task, std::size_t begin,
+                                   std::size_t end)) {
+  if (workers_.empty() || count < 2) {
+    if (count != 0) {
+      call(task, 0, count);
+    }
+
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    task_ = task;
+    call_ = call;
+    count_ = count;
+    // several chunks per thread, so that a thread which got a crowded part
+    // of the flock doesn't keep the others waiting.
+    chunk_ = std::max<std::size_t>(1, count / (8 * thread_count()));
+    next_begin_.store(0);
+    busy_workers_ = workers_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+
+  run_chunks();
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  done_.wait(lock, [this] { return busy_workers_ == 0; });
+  task_ = nullptr;
+  call_ = nullptr;
+}
+}  // namespace pr
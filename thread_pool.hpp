@@ -0,0 +1,71 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pr {
+// fixed set of worker threads, created once and reused by every call of
+// parallel_for(), so that no thread is started during the simulation.
+class Thread_pool {
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+
+  std::condition_variable start_;
+
+  std::condition_variable done_;
+
+  // the task of the running parallel_for(), called through "call_" so that
+  // it is never copied: parallel_for() doesn't allocate.
+  const void* task_;
+
+  void (*call_)(const void* task, std::size_t begin, std::size_t end);
+
+  std::size_t count_;
+
+  std::size_t chunk_;
+
+  std::atomic<std::size_t> next_begin_;
+
+  std::size_t generation_;
+
+  std::size_t busy_workers_;
+
+  bool stopping_;
+
+  void run_chunks();
+
+  void work();
+
+  void run(std::size_t count, const void* task,
+           void (*call)(const void* task, std::size_t begin, std::size_t end));
+
+ public:
+  explicit Thread_pool(unsigned int thread_count);
+
+  ~Thread_pool();
+
+  Thread_pool(const Thread_pool&) = delete;
+
+  Thread_pool& operator=(const Thread_pool&) = delete;
+
+  unsigned int thread_count() const;
+
+  // splits [0, count) in chunks and calls "task(begin, end)" on each of them,
+  // from the worker threads and from the calling one; it returns when every
+  // chunk is done.
+  template <typename Task>
+  void parallel_for(std::size_t count, const Task& task) {
+    run(count, &task,
+        [](const void* task, std::size_t begin, std::size_t end) {
+          (*static_cast<const Task*>(task))(begin, end);
+        });
+  }
+};
+}  // namespace pr
+
+#endif
@@ -0,0 +1,58 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the parallel_for() method") {
+  SUBCASE("Four threads, every index is visited once:") {
+    pr::Thread_pool pool{4};
+    std::vector<int> visits(10000, 0);
+
+    pool.parallel_for(visits.size(),
+                      [&visits](std::size_t begin, std::size_t end) {
+                        for (std::size_t i{begin}; i < end; ++i) {
+                          ++visits[i];
+                        }
+                      });
+
+    CHECK(pool.thread_count() == 4);
+    CHECK(std::all_of(visits.begin(), visits.end(),
+                      [](int visit) { return visit == 1; }));
+  }
+
+  SUBCASE("The same threads are reused by many calls:") {
+    pr::Thread_pool pool{3};
+    std::vector<int> visits(1000, 0);
+
+    for (int call{0}; call < 200; ++call) {
+      pool.parallel_for(visits.size(),
+                        [&visits](std::size_t begin, std::size_t end) {
+                          for (std::size_t i{begin}; i < end; ++i) {
+                            ++visits[i];
+                          }
+                        });
+    }
+
+    CHECK(std::all_of(visits.begin(), visits.end(),
+                      [](int visit) { return visit == 200; }));
+  }
+
+  SUBCASE("Single thread and empty ranges:") {
+    pr::Thread_pool pool{1};
+    std::size_t calls{0};
+
+    pool.parallel_for(0, [&calls](std::size_t, std::size_t) { ++calls; });
+    CHECK(calls == 0);
+
+    pool.parallel_for(5, [&calls](std::size_t begin, std::size_t end) {
+      CHECK(begin == 0);
+      CHECK(end == 5);
+      ++calls;
+    });
+    CHECK(pool.thread_count() == 1);
+    CHECK(calls == 1);
+  }
+}
@@ -0,0 +1,60 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+namespace pr {
+// lock-free exchange of values between one writer and one reader thread: the
+// writer fills back() and publishes it, the reader takes the latest published
+// value with refresh() and reads it in front(). Each of the three buffers is
+// owned by one side at a time, so neither side ever waits for the other, and
+// the writer can publish many times while the reader is still on a frame.
+template <typename T>
+class Triple_buffer {
+  static constexpr unsigned int index_mask{3u};
+
+  static constexpr unsigned int fresh_bit{4u};  // set when the middle buffer
+                                                // was published but not read.
+
+  std::array<T, 3> buffers_;
+
+  std::atomic<unsigned int> middle_;
+
+  unsigned int back_;  // only used by the writer.
+
+  unsigned int front_;  // only used by the reader.
+
+ public:
+  Triple_buffer() : middle_{1u}, back_{0u}, front_{2u} {}
+
+  Triple_buffer(const Triple_buffer&) = delete;
+
+  Triple_buffer& operator=(const Triple_buffer&) = delete;
+
+  T& back() { return buffers_[back_]; }
+
+  // makes the content of back() the latest value, and gives the writer a
+  // buffer the reader isn't using.
+  void publish() {
+    back_ = middle_.exchange(back_ | fresh_bit, std::memory_order_acq_rel) &
+            index_mask;
+  }
+
+  // moves front() to the latest published value: it returns false (and
+  // front() doesn't change) when nothing was published since the last call.
+  bool refresh() {
+    if ((middle_.load(std::memory_order_relaxed) & fresh_bit) == 0u) {
+      return false;
+    }
+
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index_mask;
+
+    return true;
+  }
+
+  const T& front() const { return buffers_[front_]; }
+};
+}  // namespace pr
+
+#endif
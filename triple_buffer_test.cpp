@@ -0,0 +1,74 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "triple_buffer.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("Testing the publish() and refresh() methods") {
+  pr::Triple_buffer<int> buffer;
+
+  SUBCASE("Nothing published:") { CHECK(buffer.refresh() == false); }
+
+  SUBCASE("The reader gets the latest value:") {
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+
+    CHECK(buffer.refresh() == true);
+    CHECK(buffer.front() == 2);
+    CHECK(buffer.refresh() == false);
+    CHECK(buffer.front() == 2);
+  }
+
+  SUBCASE("The front doesn't change while the writer goes on:") {
+    buffer.back() = 1;
+    buffer.publish();
+    CHECK(buffer.refresh() == true);
+
+    for (int value{2}; value < 10; ++value) {
+      buffer.back() = value;
+      buffer.publish();
+      CHECK(buffer.front() == 1);
+    }
+
+    CHECK(buffer.refresh() == true);
+    CHECK(buffer.front() == 9);
+  }
+}
+
+TEST_CASE("Testing a writer and a reader on two threads") {
+  pr::Triple_buffer<std::vector<int>> buffer;
+  const int values{20000};
+
+  std::thread writer{[&buffer] {
+    for (int value{1}; value <= values; ++value) {
+      buffer.back().assign(64, value);
+      buffer.publish();
+    }
+  }};
+
+  // every value seen by the reader is whole, and never older than the
+  // previous one.
+  bool whole{true};
+  bool in_order{true};
+  int last_value{0};
+
+  while (last_value < values) {
+    if (buffer.refresh()) {
+      const std::vector<int>& front = buffer.front();
+      whole = whole && front.size() == 64 &&
+              std::all_of(front.begin(), front.end(),
+                          [&front](int value) { return value == front[0]; });
+      in_order = in_order && front[0] > last_value;
+      last_value = front[0];
+    }
+  }
+  writer.join();
+
+  CHECK(whole == true);
+  CHECK(in_order == true);
+}
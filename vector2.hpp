@@ -1,39 +1,98 @@
 #ifndef VECTOR2_HPP
 #define VECTOR2_HPP
 
+#include <cassert>
+#include <cmath>
+
 namespace pr {
+// every operation is defined here, so that the compiler can inline the
+// vector maths of the rule loops; Vector2 is trivially copyable.
 class Vector2 {
   float x_;
 
   float y_;
 
  public:
-  Vector2();
+  constexpr Vector2() : x_{0.f}, y_{0.f} {}
+
+  constexpr Vector2(float x, float y) : x_{x}, y_{y} {}
+
+  constexpr float x_axis() const { return x_; }
+
+  constexpr float y_axis() const { return y_; }
+
+  constexpr Vector2& operator+=(const Vector2& other_vector) {
+    x_ += other_vector.x_;
+    y_ += other_vector.y_;
+
+    return *this;
+  }
+
+  constexpr Vector2& operator-=(const Vector2& other_vector) {
+    x_ -= other_vector.x_;
+    y_ -= other_vector.y_;
+
+    return *this;
+  }
+
+  constexpr Vector2& operator*=(float scalar) {
+    x_ *= scalar;
+    y_ *= scalar;
+
+    return *this;
+  }
+
+  constexpr Vector2 operator-() const { return Vector2{-x_, -y_}; }
+
+  constexpr Vector2 operator+(const Vector2& other_vector) const {
+    return Vector2{x_ + other_vector.x_, y_ + other_vector.y_};
+  }
 
-  Vector2(float x, float y);
+  constexpr Vector2 operator-(const Vector2& other_vector) const {
+    return Vector2{x_ - other_vector.x_, y_ - other_vector.y_};
+  }
 
-  float x_axis() const;
+  float distance(const Vector2& other_vector) const {
+    const float distance = std::sqrt(squared_distance(other_vector));
+    assert(distance >= 0.f);
 
-  float y_axis() const;
+    return distance;
+  }
 
-  Vector2 operator+=(const Vector2& other_vector);
+  // no sqrt: to compare a distance with a radius, compare it with the radius
+  // squared.
+  constexpr float squared_distance(const Vector2& other_vector) const {
+    const float difference_x = x_ - other_vector.x_;
+    const float difference_y = y_ - other_vector.y_;
 
-  Vector2 operator+(const Vector2& other_vector) const;
+    return difference_x * difference_x + difference_y * difference_y;
+  }
 
-  Vector2 operator-(const Vector2& other_vector) const;
+  float lenght_of_vector() const {
+    const float lenght = std::sqrt(squared_lenght_of_vector());
+    assert(lenght >= 0.f);
 
-  float distance(const Vector2& other_vector) const;
+    return lenght;
+  }
 
-  float lenght_of_vector() const;
+  constexpr float squared_lenght_of_vector() const { return x_ * x_ + y_ * y_; }
 
-  bool operator!=(const Vector2& other_vector) const;
+  constexpr bool operator!=(const Vector2& other_vector) const {
+    return (x_ != other_vector.x_ || y_ != other_vector.y_);
+  }
 
-  bool operator==(const Vector2& other_vector) const;
+  constexpr bool operator==(const Vector2& other_vector) const {
+    return !(*this != other_vector);
+  }
 
-  float dot_product(const Vector2& other_vector) const;
+  constexpr float dot_product(const Vector2& other_vector) const {
+    return x_ * other_vector.x_ + y_ * other_vector.y_;
+  }
 
-  Vector2 operator*(float scalar) const;
+  constexpr Vector2 operator*(float scalar) const {
+    return Vector2{scalar * x_, scalar * y_};
+  }
 };
 }  // namespace pr
 
-#endif
\ No newline at end of file
+#endif
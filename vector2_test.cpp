@@ -1,8 +1,12 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "vector2.hpp"
 
+#include <type_traits>
+
 #include "doctest.h"
 
+static_assert(std::is_trivially_copyable_v<pr::Vector2>);
+
 TEST_CASE("Testing the operator+=") {
   SUBCASE("Positive components:") {
     pr::Vector2 v1{2.f, 2.f};
@@ -101,6 +105,17 @@ TEST_CASE("Testing lenght_of_vector() method") {
   CHECK(lenght == doctest::Approx(5.0).epsilon(0.1));
 }
 
+TEST_CASE("Testing squared_distance() and squared_lenght_of_vector() methods") {
+  const pr::Vector2 v1{2.f, 3.f};
+  const pr::Vector2 v2{5.f, 7.f};
+
+  CHECK(v1.squared_distance(v2) == 25.f);
+  CHECK(v2.squared_distance(v1) == 25.f);
+  CHECK(v1.squared_distance(v1) == 0.f);
+  CHECK(v2.squared_lenght_of_vector() == 74.f);
+  CHECK(v1.distance(v2) == 5.f);
+}
+
 TEST_CASE("Testing operator!=") {
   SUBCASE("Same vectors:") {
     const pr::Vector2 v1{1.f, 2.f};
@@ -221,3 +236,45 @@ TEST_CASE("Testing operator*") {
     CHECK(x.y_axis() == doctest::Approx(0.0).epsilon(0.1));
   }
 }
+
+TEST_CASE("Testing operator-=, operator*= and the unary operator-") {
+  pr::Vector2 v1{2.f, -1.f};
+  const pr::Vector2 v2{3.f, 4.f};
+
+  SUBCASE("operator-=:") {
+    v1 -= v2;
+
+    CHECK(v1.x_axis() == doctest::Approx(-1.0));
+    CHECK(v1.y_axis() == doctest::Approx(-5.0));
+  }
+
+  SUBCASE("operator*=:") {
+    v1 *= -2.f;
+
+    CHECK(v1.x_axis() == doctest::Approx(-4.0));
+    CHECK(v1.y_axis() == doctest::Approx(2.0));
+  }
+
+  SUBCASE("Unary operator-:") {
+    CHECK(-v1 == pr::Vector2{-2.f, 1.f});
+    CHECK(-pr::Vector2{} == pr::Vector2{});
+  }
+
+  SUBCASE("The compound operators return the vector itself:") {
+    (v1 += v2) *= 2.f;
+
+    CHECK(v1 == pr::Vector2{10.f, 6.f});
+    CHECK(&(v1 -= v2) == &v1);
+  }
+}
+
+TEST_CASE("Testing the operations in constant expressions") {
+  constexpr pr::Vector2 v1{3.f, 4.f};
+  constexpr pr::Vector2 v2 = -v1 * 2.f + pr::Vector2{1.f, 1.f};
+
+  static_assert(v2 == pr::Vector2{-5.f, -7.f});
+  static_assert(v1.squared_lenght_of_vector() == 25.f);
+  static_assert(v1.dot_product(v2) == -43.f);
+
+  CHECK(v1.lenght_of_vector() == doctest::Approx(5.0));
+}